@@ -0,0 +1,167 @@
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "uhsm/event_log.h"
+#include "uhsm/latency_histogram.h"
+#include "../size/size_machine.h"
+
+// records a synthetic event stream for the sample state machine or replays a recorded stream
+// at full speed, reporting throughput, latency percentiles and a hash of the final configuration
+//   uhsm_replay_<mode> record <file> <event count> [seed]
+//   uhsm_replay_<mode> <file>
+
+using Size_log = uhsm::Event_log<Size::Event<0>, Size::Event<1>, Size::Event<2>, Size::Event<3>,
+  Size::Event<4>, Size::Event<5>, Size::Event<6>, Size::Event<7>>;
+
+namespace
+{
+  struct File_writer {
+    std::FILE* file;
+
+    void operator()(const void* data, std::size_t size)
+    {
+      std::fwrite(data, 1, size, file);
+    }
+  };
+
+  int record(const char* path, long event_count, std::uint32_t seed)
+  {
+    std::FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) {
+      std::perror(path);
+      return EXIT_FAILURE;
+    }
+
+    Size_log::Recorder<File_writer> recorder{File_writer{file}};
+
+    for (long i = 0; i < event_count; ++i) {
+      seed = seed * 1664525 + 1013904223;
+      const std::uint32_t payload = seed >> 8;
+
+      switch ((seed >> 28) % 8) {
+        case 0: recorder.record(Size::Event<0>{payload}); break;
+        case 1: recorder.record(Size::Event<1>{payload}); break;
+        case 2: recorder.record(Size::Event<2>{payload}); break;
+        case 3: recorder.record(Size::Event<3>{payload}); break;
+        case 4: recorder.record(Size::Event<4>{payload}); break;
+        case 5: recorder.record(Size::Event<5>{payload}); break;
+        case 6: recorder.record(Size::Event<6>{payload}); break;
+        case 7: recorder.record(Size::Event<7>{payload}); break;
+      }
+    }
+
+    std::fclose(file);
+    return EXIT_SUCCESS;
+  }
+
+  // FNV-1a hash of the current innermost state and of the data accumulated by hooks
+  std::uint64_t configuration_hash(const Size_machine& sm)
+  {
+    const std::uint64_t words[] = {sm.current_leaf_id(), Size::hook_count};
+    std::uint64_t hash = 14695981039346656037ull;
+
+    for (const auto word : words) {
+      for (int i = 0; i < 8; ++i) {
+        hash = (hash ^ ((word >> (8 * i)) & 0xFF)) * 1099511628211ull;
+      }
+    }
+
+    return hash;
+  }
+
+  int replay(const char* path)
+  {
+    const int fd = open(path, O_RDONLY);
+    struct stat file_stat;
+    if (fd < 0 || fstat(fd, &file_stat) != 0) {
+      std::perror(path);
+      return EXIT_FAILURE;
+    }
+
+    const auto size = static_cast<std::size_t>(file_stat.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      std::perror(path);
+      close(fd);
+      return EXIT_FAILURE;
+    }
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    using Clock = std::chrono::steady_clock;
+
+    // 1st pass: throughput without per-event timing
+    Size::hook_count = 0;
+    Size_machine sm{};
+    sm.start();
+    Size_log::Reader<Size_machine> reader{data, size};
+    long event_count = 0;
+
+    const auto start = Clock::now();
+    while (reader.dispatch_next(sm)) {
+      ++event_count;
+    }
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    if (!reader.at_end() || event_count == 0) {
+      std::fprintf(stderr, "%s: empty or malformed event stream\n", path);
+      return EXIT_FAILURE;
+    }
+    const auto hash = configuration_hash(sm);
+
+    // 2nd pass: latency of each event
+    // NOTE: measured latencies include the overhead of reading the clock
+    Size::hook_count = 0;
+    Size_machine timed_sm{};
+    timed_sm.start();
+    Size_log::Reader<Size_machine> timed_reader{data, size};
+    uhsm::Latency_histogram histogram;
+
+    for (auto before = Clock::now();; ) {
+      if (!timed_reader.dispatch_next(timed_sm)) {
+        break;
+      }
+      const auto after = Clock::now();
+      histogram.record(static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(after - before).count()));
+      before = after;
+    }
+
+    std::printf("events: %ld\n", event_count);
+    std::printf("throughput: %.0f events/s\n", static_cast<double>(event_count) / elapsed.count());
+    std::printf("latency [ns]: p50 %" PRIu64 " p90 %" PRIu64 " p99 %" PRIu64 " p99.9 %" PRIu64 " max %" PRIu64 "\n",
+      histogram.percentile(0.5), histogram.percentile(0.9), histogram.percentile(0.99),
+      histogram.percentile(0.999), histogram.percentile(1.0));
+    std::printf("configuration hash: %016" PRIx64 "\n", hash);
+
+    munmap(data, size);
+    close(fd);
+
+    if (configuration_hash(timed_sm) != hash) {
+      std::fprintf(stderr, "%s: replay is not deterministic\n", path);
+      return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc >= 4 && std::strcmp(argv[1], "record") == 0) {
+    const auto seed = argc > 4 ? static_cast<std::uint32_t>(std::atol(argv[4])) : 1u;
+    return record(argv[2], std::atol(argv[3]), seed);
+  }
+
+  if (argc == 2) {
+    return replay(argv[1]);
+  }
+
+  std::fprintf(stderr, "usage: %s record <file> <event count> [seed]\n       %s <file>\n", argv[0], argv[0]);
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,91 @@
+#ifndef UHSM_BENCH_SIZE_MACHINE_H_
+#define UHSM_BENCH_SIZE_MACHINE_H_
+
+#include <cstdint>
+#include "uhsm/state_machine.h"
+
+// NOTE: a sample state machine of a considerable size (3 hierarchy levels, 84 states, 8 events)
+// generated with preprocessor macros; dispatch implementation is selected with
+// `UHSM_SIZE_DISPATCH_MODE` macro
+
+namespace Size
+{
+  template<int N>
+  struct Event {
+    std::uint32_t payload;
+  };
+
+  inline std::uint32_t hook_count = 0;
+
+  struct Count_action {
+    template<typename SrcStateT, typename EventT>
+    void operator()(const SrcStateT&, const EventT& evt)
+    {
+      hook_count += evt.payload;
+    }
+  };
+
+  struct Counting_hooks {
+    template<typename EventT>
+    void on_entry(const EventT&) { ++hook_count; }
+    template<typename EventT>
+    void on_exit(const EventT&) { --hook_count; }
+  };
+}
+
+#define UHSM_SIZE_STATE(Name) \
+  struct Name : Simple_state<Name>, Size::Counting_hooks { \
+    using Size::Counting_hooks::on_entry; \
+    using Size::Counting_hooks::on_exit; \
+  };
+
+#define UHSM_SIZE_TRANSITIONS(S0, S1, S2, S3, E0, E1, E2, E3) \
+  Transition<S0, Size::Event<E0>, S1, Size::Count_action>, \
+  Transition<S1, Size::Event<E1>, S2>, \
+  Transition<S2, Size::Event<E2>, S3, Size::Count_action>, \
+  Transition<S3, Size::Event<E3>, S0>, \
+  Transition<S0, Size::Event<E2>, S2>, \
+  Transition<S1, Size::Event<E3>, S1, Size::Count_action>, \
+  Transition<S2, Size::Event<E0>, S0>, \
+  Transition<S3, Size::Event<E1>, S1>
+
+#define UHSM_SIZE_INNER_MACHINE(Name, E0, E1, E2, E3) \
+  struct Name : Substate_machine<Name>, Size::Counting_hooks { \
+    using Size::Counting_hooks::on_entry; \
+    using Size::Counting_hooks::on_exit; \
+    UHSM_SIZE_STATE(Leaf_a) \
+    UHSM_SIZE_STATE(Leaf_b) \
+    UHSM_SIZE_STATE(Leaf_c) \
+    UHSM_SIZE_STATE(Leaf_d) \
+    using Initial = Leaf_a; \
+    using Transitions = Transition_table<UHSM_SIZE_TRANSITIONS(Leaf_a, Leaf_b, Leaf_c, Leaf_d, E0, E1, E2, E3)>; \
+    State_data_def<Transitions> state_data; \
+  };
+
+#define UHSM_SIZE_OUTER_MACHINE(Name, E0, E1, E2, E3) \
+  struct Name : Substate_machine<Name>, Size::Counting_hooks { \
+    using Size::Counting_hooks::on_entry; \
+    using Size::Counting_hooks::on_exit; \
+    UHSM_SIZE_INNER_MACHINE(Sub_a, E1, E2, E3, E0) \
+    UHSM_SIZE_INNER_MACHINE(Sub_b, E2, E3, E0, E1) \
+    UHSM_SIZE_INNER_MACHINE(Sub_c, E3, E0, E1, E2) \
+    UHSM_SIZE_INNER_MACHINE(Sub_d, E0, E1, E2, E3) \
+    using Initial = Sub_a; \
+    using Transitions = Transition_table<UHSM_SIZE_TRANSITIONS(Sub_a, Sub_b, Sub_c, Sub_d, E0, E1, E2, E3)>; \
+    State_data_def<Transitions> state_data; \
+  };
+
+struct Size_machine : uhsm::State_machine<Size_machine> {
+  static constexpr auto dispatch_mode = uhsm::Dispatch_mode::UHSM_SIZE_DISPATCH_MODE;
+
+  UHSM_SIZE_OUTER_MACHINE(Mode_a, 4, 5, 6, 7)
+  UHSM_SIZE_OUTER_MACHINE(Mode_b, 5, 6, 7, 4)
+  UHSM_SIZE_OUTER_MACHINE(Mode_c, 6, 7, 4, 5)
+  UHSM_SIZE_OUTER_MACHINE(Mode_d, 7, 4, 5, 6)
+
+  using Initial = Mode_a;
+  using Transitions = Transition_table<UHSM_SIZE_TRANSITIONS(Mode_a, Mode_b, Mode_c, Mode_d, 0, 1, 2, 3)>;
+  State_data_def<Transitions> state_data;
+};
+
+#endif
@@ -0,0 +1,32 @@
+#include <cstdio>
+#include <cstdlib>
+#include "size_machine.h"
+
+// feeds the sample state machine with a pseudo-random sequence of events so that
+// dispatch code for all event types is emitted
+int main(int argc, char* argv[])
+{
+  Size_machine sm;
+  sm.start();
+
+  std::uint32_t seed = argc > 1 ? static_cast<std::uint32_t>(std::atoi(argv[1])) : 1;
+
+  for (int i = 0; i < 1000; ++i) {
+    seed = seed * 1664525 + 1013904223;
+    const std::uint32_t payload = seed >> 8;
+
+    switch ((seed >> 28) % 8) {
+      case 0: sm.react(Size::Event<0>{payload}); break;
+      case 1: sm.react(Size::Event<1>{payload}); break;
+      case 2: sm.react(Size::Event<2>{payload}); break;
+      case 3: sm.react(Size::Event<3>{payload}); break;
+      case 4: sm.react(Size::Event<4>{payload}); break;
+      case 5: sm.react(Size::Event<5>{payload}); break;
+      case 6: sm.react(Size::Event<6>{payload}); break;
+      case 7: sm.react(Size::Event<7>{payload}); break;
+    }
+  }
+
+  std::printf("%u\n", Size::hook_count);
+  return 0;
+}
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "uhsm/instance_store.h"
+#include "../size/size_machine.h"
+
+// compares lookup-and-react of state machine instances keyed by a 64-bit session ID between
+// `uhsm::Instance_store` (single and batched lookups) and `std::unordered_map`
+//   uhsm_store [instance count (default 10M)] [packet count (default 10M)]
+
+namespace
+{
+  // splitmix64; gives well-spread pseudo-random session IDs
+  std::uint64_t next_id(std::uint64_t& state)
+  {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  void react(Size_machine& sm, std::uint64_t id)
+  {
+    switch (id % 8) {
+      case 0: sm.react(Size::Event<0>{1}); break;
+      case 1: sm.react(Size::Event<1>{1}); break;
+      case 2: sm.react(Size::Event<2>{1}); break;
+      case 3: sm.react(Size::Event<3>{1}); break;
+      case 4: sm.react(Size::Event<4>{1}); break;
+      case 5: sm.react(Size::Event<5>{1}); break;
+      case 6: sm.react(Size::Event<6>{1}); break;
+      case 7: sm.react(Size::Event<7>{1}); break;
+    }
+  }
+
+  template<typename FnT>
+  void measure(const char* name, std::size_t op_count, FnT&& fn)
+  {
+    using Clock = std::chrono::steady_clock;
+
+    Size::hook_count = 0;
+    const auto start = Clock::now();
+    fn();
+    const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+
+    std::printf("%-24s %8.1f ns/op (checksum %u)\n", name, elapsed.count() / static_cast<double>(op_count),
+      Size::hook_count);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const std::size_t instance_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+  const std::size_t packet_count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10'000'000;
+
+  std::vector<std::uint64_t> ids(instance_count);
+  std::uint64_t seed = 1;
+  for (auto& id : ids) {
+    id = next_id(seed);
+  }
+
+  // IDs of incoming packets, uniformly spread over all instances
+  std::vector<std::uint64_t> packets(packet_count);
+  for (auto& packet : packets) {
+    packet = ids[next_id(seed) % instance_count];
+  }
+
+  std::printf("instances: %zu, packets: %zu, instance size: %zu B\n", instance_count, packet_count,
+    sizeof(Size_machine));
+
+  {
+    auto store = std::make_unique<uhsm::Instance_store<Size_machine>>(instance_count);
+
+    measure("store insert", instance_count, [&] {
+      store->insert_bulk(ids.data(), ids.size());
+    });
+    measure("store react", packet_count, [&] {
+      for (const auto id : packets) {
+        react(*store->find(id), id);
+      }
+    });
+    // NOTE: instances are restarted (not measured), so each react row runs the same event sequence
+    // from the same configurations and their checksums match
+    for (const auto id : ids) {
+      store->find(id)->start();
+    }
+    measure("store batched react", packet_count, [&] {
+      Size_machine* found[uhsm::Instance_store<Size_machine>::batch_size];
+      for (std::size_t base = 0; base < packet_count; base += std::size(found)) {
+        const std::size_t count = std::min(std::size(found), packet_count - base);
+        store->find_batch(&packets[base], count, found);
+        for (std::size_t i = 0; i < count; ++i) {
+          react(*found[i], packets[base + i]);
+        }
+      }
+    });
+    measure("store erase", instance_count, [&] {
+      store->erase_bulk(ids.data(), ids.size());
+    });
+  }
+
+  {
+    std::unordered_map<std::uint64_t, Size_machine> map;
+
+    measure("unordered_map insert", instance_count, [&] {
+      for (const auto id : ids) {
+        map.try_emplace(id).first->second.start();
+      }
+    });
+    measure("unordered_map react", packet_count, [&] {
+      for (const auto id : packets) {
+        react(map.find(id)->second, id);
+      }
+    });
+    measure("unordered_map erase", instance_count, [&] {
+      for (const auto id : ids) {
+        map.erase(id);
+      }
+    });
+  }
+
+  return EXIT_SUCCESS;
+}
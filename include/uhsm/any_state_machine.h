@@ -0,0 +1,139 @@
+#ifndef UHSM_ANY_STATE_MACHINE_H_
+#define UHSM_ANY_STATE_MACHINE_H_
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "uhsm/helpers.h"
+#include "uhsm/cross_transition.h"
+
+// NOTE: a non-owning, type-erased handle of a topmost state machine of any type accepting events
+// of a common event list; the handle consists of a pointer to the state machine and a pointer
+// to a constant table of entry points generated at compile time for its type (`react()` for each
+// event of the list, `start()` and the configuration query), so it is two pointers in size,
+// trivially copyable and never allocates; each call is a single indirect call
+// NOTE: events of the list which a state machine does not handle are filtered out at compile time
+// (their entries only return false)
+// NOTE: entries for both an rvalue and a const lvalue of each event are instantiated, so hooks and actions
+// of a state machine must accept events of the list passed via const-reference
+
+namespace uhsm
+{
+  template<typename... EventTs>
+  class Any_state_machine {
+  public:
+    // gives an index of an event type within the event list (the event ID)
+    template<typename EventT>
+    static constexpr std::size_t event_idx = utils::tuple_elem_idx_v<utils::remove_cvref_t<EventT>, std::tuple<EventTs...>>;
+
+    // entry points of a single state machine type
+    struct Entry_points {
+      std::array<bool (*)(void*, void*), sizeof...(EventTs)> react_moving;
+      std::array<bool (*)(void*, const void*), sizeof...(EventTs)> react_const;
+      void (*start)(void*);
+      helpers::State_id (*current_leaf_id)(const void*);
+    };
+
+    // NOTE: a default-constructed handle is not bound to any state machine and may not be used
+    // other than being assigned to
+    Any_state_machine() = default;
+
+    template<typename StateMachineT, typename = std::enable_if_t<!std::is_same_v<StateMachineT, Any_state_machine>>>
+    explicit Any_state_machine(StateMachineT& sm) : sm_{&sm}, entry_points_{&Table<StateMachineT>::entry_points}
+    {
+      static_assert(helpers::is_root_state_v<StateMachineT>, "Only a topmost state machine can be referred to by a handle");
+    }
+
+    void start()
+    {
+      entry_points_->start(sm_);
+    }
+
+    // passes an event to the state machine with its original value category
+    template<typename EventT>
+    bool react(EventT&& evt)
+    {
+      if constexpr (std::is_lvalue_reference_v<EventT>) {
+        return entry_points_->react_const[event_idx<EventT>](sm_, &evt);
+      } else {
+        return entry_points_->react_moving[event_idx<EventT>](sm_, &evt);
+      }
+    }
+
+    // passes an event given by its ID (known at runtime) and a pointer to an object of the event type
+    bool react(std::size_t event_id, const void* evt)
+    {
+      return entry_points_->react_const[event_id](sm_, evt);
+    }
+
+    // gives the global identifier of the current innermost state of the state machine
+    helpers::State_id current_leaf_id() const
+    {
+      return entry_points_->current_leaf_id(sm_);
+    }
+
+    // gives the state machine if it is of a given type (or nullptr)
+    template<typename StateMachineT>
+    StateMachineT* target() const
+    {
+      return entry_points_ == &Table<StateMachineT>::entry_points ? static_cast<StateMachineT*>(sm_) : nullptr;
+    }
+
+    bool bound() const
+    {
+      return sm_ != nullptr;
+    }
+
+  private:
+    template<typename StateMachineT>
+    struct Table {
+      template<typename EventT>
+      static constexpr bool handles_event = helpers::handles_event_v<StateMachineT, EventT> ||
+        helpers::has_cross_tr_w_event_v<StateMachineT, EventT>;
+
+      template<typename EventT>
+      static bool react_moving(void* sm, void* evt)
+      {
+        if constexpr (handles_event<EventT>) {
+          return static_cast<StateMachineT*>(sm)->react(std::move(*static_cast<EventT*>(evt)));
+        } else {
+          return false;
+        }
+      }
+
+      template<typename EventT>
+      static bool react_const(void* sm, const void* evt)
+      {
+        if constexpr (handles_event<EventT>) {
+          return static_cast<StateMachineT*>(sm)->react(*static_cast<const EventT*>(evt));
+        } else {
+          return false;
+        }
+      }
+
+      static void start(void* sm)
+      {
+        static_cast<StateMachineT*>(sm)->start();
+      }
+
+      static helpers::State_id current_leaf_id(const void* sm)
+      {
+        return static_cast<const StateMachineT*>(sm)->current_leaf_id();
+      }
+
+      static constexpr Entry_points entry_points = {
+        {{&react_moving<EventTs>...}},
+        {{&react_const<EventTs>...}},
+        &start,
+        &current_leaf_id
+      };
+    };
+
+    void* sm_ = nullptr;
+    const Entry_points* entry_points_ = nullptr;
+  };
+}
+
+#endif
@@ -0,0 +1,266 @@
+#ifndef UHSM_COMPACT_DISPATCH_H_
+#define UHSM_COMPACT_DISPATCH_H_
+
+#include <array>
+#include <cstdint>
+#include "uhsm/helpers.h"
+
+// NOTE: an alternative implementation of the base algorithm of a hierarchical state machine
+// optimized for code size; each hierarchy level's transition table is encoded as constant arrays
+// of bytes which are searched by a single, shared (non-template) function; calls which depend
+// on state and event types are performed via constant tables of function pointers indexed
+// by a state/transition index instead of being inlined into nested chains of comparisons
+
+#if defined(__GNUC__)
+#define UHSM_COMPACT_NOINLINE __attribute__((noinline))
+#else
+#define UHSM_COMPACT_NOINLINE
+#endif
+
+namespace uhsm::helpers
+{
+  // indicates that no transition matching the current state and event was found
+  inline constexpr std::uint8_t no_compact_transition = 0xFF;
+
+  // searches a table of encoded transitions (consecutive triples of source state index,
+  // event index and dest. state index) for a transition with given source state and event;
+  // gives an index of the transition or `no_compact_transition`
+  UHSM_COMPACT_NOINLINE constexpr std::uint8_t find_compact_transition(const std::uint8_t* rows,
+    std::size_t row_count, std::size_t src_state_idx, std::uint8_t event_idx)
+  {
+    for (std::size_t i = 0; i < row_count; ++i, rows += 3) {
+      if (rows[0] == src_state_idx && rows[1] == event_idx) {
+        return static_cast<std::uint8_t>(i);
+      }
+    }
+
+    return no_compact_transition;
+  }
+
+  // encoded transition table of a single hierarchy level;
+  // NOTE: can be specialized for a given state type to provide a precomputed table
+  template<typename StateT>
+  struct Compact_table {
+    using Transitions = typename StateT::Transitions;
+    using State_set = typename StateT::template State_set<StateT>;
+    using Event_set = extract_event_set_t<Transitions>;
+
+    static constexpr std::size_t row_count = std::tuple_size_v<Transitions>;
+
+    template<typename EventT>
+    static constexpr std::uint8_t event_idx = static_cast<std::uint8_t>(utils::tuple_elem_idx_v<EventT, Event_set>);
+
+    template<std::size_t... Is>
+    static constexpr auto encode(std::index_sequence<Is...>)
+    {
+      return std::array<std::uint8_t, 3 * row_count>{{
+        (Is % 3 == 0 ? static_cast<std::uint8_t>(get_tr_src_state_idx_v<State_set,
+          std::tuple_element_t<Is / 3, Transitions>>) :
+        Is % 3 == 1 ? event_idx<get_tr_event<std::tuple_element_t<Is / 3, Transitions>>> :
+        static_cast<std::uint8_t>(get_tr_dest_state_idx_v<State_set,
+          std::tuple_element_t<Is / 3, Transitions>>))...
+      }};
+    }
+
+    static constexpr auto rows = encode(std::make_index_sequence<3 * row_count>{});
+  };
+
+  // invokes on_exit on a current state of a single hierarchy level and (beforehand) on all of its
+  // current nested states; nested hierarchy levels are exited via their own tables instead of
+  // inlining the whole cascade for each exited state
+  template<typename StateT, typename EventT, typename RootStateT>
+  struct Compact_exit {
+    using Nested_state_set = typename StateT::template State_set<StateT>;
+    using Exit_fn = void (*)(StateT&, const EventT&, RootStateT&);
+
+    template<std::size_t I>
+    static void exit(StateT& state, const EventT& evt, RootStateT& root)
+    {
+      using Exited_state = std::tuple_element_t<I, Nested_state_set>;
+      auto& exited_state = *std::get_if<I>(&state.state_data);
+
+      if constexpr (is_composite_state_v<Exited_state>) {
+        Compact_exit<Exited_state, EventT, RootStateT>::exit_current(exited_state, evt, root);
+      }
+      invoke_on_exit(exited_state, evt, root);
+    }
+
+    template<std::size_t... Is>
+    static constexpr auto make_exit_table(std::index_sequence<Is...>)
+    {
+      return std::array<Exit_fn, sizeof...(Is)>{{&exit<Is>...}};
+    }
+
+    static void exit_current(StateT& state, const EventT& evt, RootStateT& root)
+    {
+      static constexpr auto exits = make_exit_table(std::make_index_sequence<std::tuple_size_v<Nested_state_set>>{});
+      exits[state.state_data.index()](state, evt, root);
+    }
+  };
+
+  // dispatches an event at a single hierarchy level using the encoded transition table
+  template<typename StateT, typename EventT, typename RootStateT>
+  struct Compact_dispatcher {
+    using Event = utils::remove_cvref_t<EventT>;
+    using Table = Compact_table<StateT>;
+    using Nested_state_set = typename StateT::template State_set<StateT>;
+    using Transitions = typename StateT::Transitions;
+    static constexpr std::size_t state_count = std::tuple_size_v<Nested_state_set>;
+
+    // NOTE: checked here rather than by the table, so precomputed (specialized) tables are checked as well
+    static_assert(Table::row_count < no_compact_transition && state_count < no_compact_transition &&
+      std::tuple_size_v<extract_event_set_t<Transitions>> < no_compact_transition,
+      "Compact dispatch supports up to 254 transitions, states and events per hierarchy level");
+
+    using Nested_react_fn = bool (*)(StateT&, EventT&&, RootStateT&);
+    using Action_fn = void (*)(StateT&, EventT&&, RootStateT&);
+    using Enter_fn = void (*)(StateT&, EventT&&, RootStateT&);
+
+    template<typename NestedStateT>
+    using Nested_handles_event = handles_event<NestedStateT, Event>;
+
+    template<std::size_t I>
+    static bool nested_react(StateT& state, EventT&& evt, RootStateT& root)
+    {
+      return std::get_if<I>(&state.state_data)->private_react(std::forward<EventT>(evt), root);
+    }
+
+    static bool nested_ignore(StateT&, EventT&&, RootStateT&)
+    {
+      return false;
+    }
+
+    template<std::size_t I>
+    static constexpr Nested_react_fn get_nested_react()
+    {
+      // NOTE: nested states whose hierarchy cannot handle the event share a single entry
+      if constexpr (handles_event_v<std::tuple_element_t<I, Nested_state_set>, Event>) {
+        return &nested_react<I>;
+      } else {
+        return &nested_ignore;
+      }
+    }
+
+    template<std::size_t R>
+    static void perform_action(StateT& state, EventT&& evt, RootStateT& root)
+    {
+      using Transition = std::tuple_element_t<R, Transitions>;
+      auto& src_state = *std::get_if<get_tr_src_state_idx_v<Nested_state_set, Transition>>(&state.state_data);
+
+      if constexpr (std::is_same_v<get_tr_src_state<Transition>, get_tr_dest_state<Transition>>) {
+        Action_invocation<Transition>::invoke(src_state, std::forward<EventT>(evt), root);
+      } else {
+        Action_invocation<Transition>::invoke(src_state, std::as_const(evt), root);
+      }
+    }
+
+    template<std::size_t R>
+    static constexpr Action_fn get_action()
+    {
+      // NOTE: transitions triggered by other events are never matched
+      if constexpr (std::is_same_v<get_tr_event<std::tuple_element_t<R, Transitions>>, Event>) {
+        return &perform_action<R>;
+      } else {
+        return nullptr;
+      }
+    }
+
+    template<std::size_t I>
+    static void enter(StateT& state, EventT&& evt, RootStateT& root)
+    {
+      enter_dest_state<I>(state.state_data, std::forward<EventT>(evt), root);
+    }
+
+    template<std::size_t... Is>
+    static constexpr auto make_nested_react_table(std::index_sequence<Is...>)
+    {
+      return std::array<Nested_react_fn, state_count>{{get_nested_react<Is>()...}};
+    }
+
+    template<std::size_t I>
+    static constexpr Enter_fn get_enter()
+    {
+      // NOTE: states which are never entered due to the event are never looked up
+      if constexpr (has_tr_to_dest_state_v<std::tuple_element_t<I, Nested_state_set>, Event, Transitions>) {
+        return &enter<I>;
+      } else {
+        return nullptr;
+      }
+    }
+
+    template<std::size_t... Is>
+    static constexpr auto make_enter_table(std::index_sequence<Is...>)
+    {
+      return std::array<Enter_fn, state_count>{{get_enter<Is>()...}};
+    }
+
+    template<std::size_t... Rs>
+    static constexpr auto make_action_table(std::index_sequence<Rs...>)
+    {
+      return std::array<Action_fn, sizeof...(Rs)>{{get_action<Rs>()...}};
+    }
+
+    static bool dispatch(StateT& state, EventT&& evt, RootStateT& root)
+    {
+      const auto state_idx = state.state_data.index();
+
+      if constexpr (utils::any_of_v<Nested_handles_event, Nested_state_set>) {
+        static constexpr auto nested_reacts = make_nested_react_table(std::make_index_sequence<state_count>{});
+
+        if (nested_reacts[state_idx](state, std::forward<EventT>(evt), root)) {
+          // the event was handled at more nested hierarchy level; end of processing
+          return true;
+        }
+      }
+
+      if constexpr (!has_tr_w_event_v<Event, Transitions>) {
+        return false;
+      } else {
+        // NOTE: tables are only generated for hierarchy levels with transitions triggered by the event
+        static constexpr auto actions = make_action_table(std::make_index_sequence<Table::row_count>{});
+        static constexpr auto enters = make_enter_table(std::make_index_sequence<state_count>{});
+
+        const auto tr_idx = find_compact_transition(Table::rows.data(), Table::row_count,
+          state_idx, Table::template event_idx<Event>);
+
+        if (tr_idx == no_compact_transition) {
+          return false;
+        }
+
+        actions[tr_idx](state, std::forward<EventT>(evt), root);
+
+        const auto next_state_idx = Table::rows[3 * tr_idx + 2];
+        if (next_state_idx == state_idx) {
+          // internal transition; do not call on_entry/on_exit
+          return true;
+        }
+
+        // switch the state branch (see `handle_at_level()`)
+        if constexpr (!is_elided_exit_cascade_of<utils::remove_cvref_t<decltype(state.state_data)>, RootStateT, Event>::value) {
+          Compact_exit<StateT, Event, RootStateT>::exit_current(state, evt, root);
+        }
+        enters[next_state_idx](state, std::forward<EventT>(evt), root);
+        update_active_leaf(root, Initial_leaf_ids<RootStateT, Nested_state_set>::table[next_state_idx]);
+
+        return true;
+      }
+    }
+  };
+
+  // Compile-time tests
+  ////////////////////////////////////////////////////////////////////////////////
+
+  namespace Test::FindCompactTransition_EncodedRows_ReturnMatchingRow
+  {
+    constexpr std::uint8_t rows[] = {
+      0, 0, 1,
+      1, 0, 0,
+      1, 1, 2
+    };
+
+    static_assert(find_compact_transition(rows, 3, 1, 1) == 2);
+    static_assert(find_compact_transition(rows, 3, 2, 0) == no_compact_transition);
+  }
+}
+
+#endif
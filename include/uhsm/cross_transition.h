@@ -0,0 +1,158 @@
+#ifndef UHSM_CROSS_TRANSITION_H_
+#define UHSM_CROSS_TRANSITION_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include "uhsm/helpers.h"
+
+// NOTE: cross-level transitions are declared in the topmost state machine as
+// `using Cross_transitions = Transition_table<...>;` and their source and dest. states may be
+// nested at arbitrary depths of the hierarchy; the least common ancestor (LCA) of both states
+// and the exact sequence of exited and entered states are determined at compile time, so each
+// transition executes as a single straight-line sequence of hook invocations;
+// a cross-level transition is only taken if the event has not been handled by regular transitions
+
+namespace uhsm::helpers
+{
+  // checks if the topmost state machine has a cross-level transition triggered by an event
+  template<typename RootStateT, typename EventT>
+  inline constexpr bool has_cross_tr_w_event_v = has_tr_w_event_v<utils::remove_cvref_t<EventT>,
+    cross_transitions_t<RootStateT>>;
+
+  // NOTE: type lists are passed as null pointers to tuples, so no objects are constructed
+  template<typename TargetStateT, typename HeadT, typename... TailTs>
+  constexpr auto find_state_path(std::tuple<HeadT, TailTs...>*)
+  {
+    if constexpr (std::is_same_v<HeadT, TargetStateT>) {
+      return static_cast<std::tuple<HeadT>*>(nullptr);
+    } else if constexpr (utils::contains_t<TargetStateT, nested_states_t<HeadT>>::value) {
+      using Nested_path = std::remove_pointer_t<decltype(find_state_path<TargetStateT>(
+        static_cast<typename HeadT::template State_set<HeadT>*>(nullptr)))>;
+      return static_cast<utils::prepend_t<HeadT, Nested_path>*>(nullptr);
+    } else {
+      static_assert(sizeof...(TailTs) > 0, "State is not a part of the state machine hierarchy");
+      return find_state_path<TargetStateT>(static_cast<std::tuple<TailTs...>*>(nullptr));
+    }
+  }
+
+  // gives a list of states on a path from the topmost state machine (excluded) to a given state (included)
+  template<typename RootStateT, typename StateT>
+  using state_path_t = std::remove_pointer_t<decltype(find_state_path<StateT>(
+    static_cast<typename RootStateT::template State_set<RootStateT>*>(nullptr)))>;
+
+  // gives a number of leading states two paths have in common
+  template<typename PathT, typename OtherPathT, std::size_t N = 0>
+  constexpr std::size_t common_path_prefix_size()
+  {
+    if constexpr (N < std::tuple_size_v<PathT> && N < std::tuple_size_v<OtherPathT>) {
+      if constexpr (std::is_same_v<std::tuple_element_t<N, PathT>, std::tuple_element_t<N, OtherPathT>>) {
+        return common_path_prefix_size<PathT, OtherPathT, N + 1>();
+      } else {
+        return N;
+      }
+    } else {
+      return N;
+    }
+  }
+
+  template<typename PathT, typename StateT, std::size_t... Is>
+  constexpr auto& get_on_path_impl(StateT& state, std::index_sequence<Is...>)
+  {
+    std::tuple<StateT*, std::tuple_element_t<Is, PathT>*...> states{};
+    std::get<0>(states) = &state;
+    // NOTE: states on the path to the source state of a taken transition are always current
+    ((std::get<Is + 1>(states) = std::get_if<std::tuple_element_t<Is, PathT>>(&std::get<Is>(states)->state_data)), ...);
+    return *std::get<sizeof...(Is)>(states);
+  }
+
+  // gives a current state object at a given depth of a path (the topmost state machine at depth 0)
+  // NOTE: the path is walked by a fold expression, so the call depth does not depend on the depth of the state
+  template<typename PathT, std::size_t Depth, typename StateT>
+  constexpr auto& get_on_path(StateT& state)
+  {
+    return get_on_path_impl<PathT>(state, std::make_index_sequence<Depth>{});
+  }
+
+  // enters states on a path starting at a given depth; on_entry of intermediate states observes
+  // the event, the dest. state is entered as a regular transition's dest. state would be
+  template<typename PathT, std::size_t I, typename StateT, typename EventT, typename RootStateT>
+  constexpr void enter_path(StateT& state, EventT&& evt, RootStateT& root)
+  {
+    using Entered_state = std::tuple_element_t<I, PathT>;
+
+    if constexpr (I + 1 < std::tuple_size_v<PathT>) {
+      auto& entered_state = state.state_data.template emplace<Entered_state>();
+      invoke_on_entry(entered_state, std::as_const(evt), root);
+      enter_path<PathT, I + 1>(entered_state, std::forward<EventT>(evt), root);
+    } else {
+      enter_dest_state<get_state_idx_v<Entered_state, state_set_t<StateT>>>(
+        state.state_data, std::forward<EventT>(evt), root);
+    }
+  }
+
+  // executes a single cross-level transition
+  template<typename RootStateT, typename TransitionT>
+  struct Cross_transition {
+    using Src_path = state_path_t<RootStateT, get_tr_src_state<TransitionT>>;
+    using Dest_path = state_path_t<RootStateT, get_tr_dest_state<TransitionT>>;
+
+    // NOTE: the LCA is a proper ancestor of both states, so a transition to the source state itself
+    // or to one of its ancestors exits and re-enters the dest. state
+    static constexpr std::size_t lca_depth = std::min({common_path_prefix_size<Src_path, Dest_path>(),
+      std::tuple_size_v<Src_path> - 1, std::tuple_size_v<Dest_path> - 1});
+
+    template<typename EventT>
+    static constexpr void execute(RootStateT& root, EventT&& evt)
+    {
+      auto& src_state = get_on_path<Src_path, std::tuple_size_v<Src_path>>(root);
+      Action_invocation<TransitionT>::invoke(src_state, std::as_const(evt), root);
+
+      get_on_path<Src_path, lca_depth + 1>(root).private_invoke_on_exit(std::as_const(evt), root);
+      enter_path<Dest_path, lca_depth>(get_on_path<Src_path, lca_depth>(root), std::forward<EventT>(evt), root);
+      update_active_leaf(root, initial_leaf_id_v<RootStateT, get_tr_dest_state<TransitionT>>);
+    }
+  };
+
+  template<typename RootStateT, typename EventT, typename TransitionT>
+  constexpr bool try_cross_transition(RootStateT& root, EventT&& evt)
+  {
+    if constexpr (std::is_same_v<get_tr_event<TransitionT>, utils::remove_cvref_t<EventT>>) {
+      if (is_in_subtree<RootStateT, get_tr_src_state<TransitionT>>(root.private_active_leaf_id)) {
+        Cross_transition<RootStateT, TransitionT>::execute(root, std::forward<EventT>(evt));
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  // takes the first cross-level transition (in order of declaration) triggered by the event
+  // whose source state is current
+  template<typename RootStateT, typename EventT, typename... TransitionTs>
+  constexpr bool dispatch_cross_impl(RootStateT& root, EventT&& evt, std::tuple<TransitionTs...>*)
+  {
+    // NOTE: at most one transition is taken, so the event is forwarded at most once
+    return (try_cross_transition<RootStateT, EventT, TransitionTs>(root, std::forward<EventT>(evt)) || ...);
+  }
+
+  template<typename RootStateT, typename EventT>
+  constexpr bool dispatch_cross_transition(RootStateT& root, EventT&& evt)
+  {
+    return dispatch_cross_impl(root, std::forward<EventT>(evt),
+      static_cast<cross_transitions_t<RootStateT>*>(nullptr));
+  }
+
+  // Compile-time tests
+  ////////////////////////////////////////////////////////////////////////////////
+
+  namespace Test::CommonPathPrefixSize_PathsPassed_ReturnLeadingCommonCount
+  {
+    static_assert(common_path_prefix_size<std::tuple<int, bool, char>, std::tuple<int, bool, float>>() == 2);
+    static_assert(common_path_prefix_size<std::tuple<int, bool>, std::tuple<int, bool, float>>() == 2);
+    static_assert(common_path_prefix_size<std::tuple<int>, std::tuple<bool>>() == 0);
+  }
+}
+
+#endif
@@ -0,0 +1,278 @@
+#ifndef UHSM_EVENT_BUS_H_
+#define UHSM_EVENT_BUS_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "uhsm/helpers.h"
+#include "uhsm/cross_transition.h"
+
+// NOTE: a publish/subscribe bus of state machines of a single type; each member of the bus
+// is subscribed only to those of the bus's event types which its current configuration can handle,
+// i.e. for which the current innermost state or any of its ancestors is a source state of a transition
+// (regular or cross-level); a published event is dispatched only to members linked in the intrusive
+// list of its event type, so members whose configuration ignores the event are never touched
+// NOTE: subscriptions depend only on the current innermost state, so they are precomputed for each
+// state at compile time and updated after each event dispatched to a member
+
+namespace uhsm
+{
+  namespace helpers
+  {
+    // checks if a transition table contains a transition from a given source state triggered by a given event
+    template<typename StateT, typename EventT, typename TransitionTableT>
+    struct has_tr_w_src_state_event;
+    template<typename StateT, typename EventT, typename... TransitionTs>
+    struct has_tr_w_src_state_event<StateT, EventT, uhsm::Transition_table<TransitionTs...>> {
+      static constexpr bool value = ((std::is_same_v<get_tr_src_state<TransitionTs>, StateT> &&
+        std::is_same_v<get_tr_event<TransitionTs>, EventT>) || ...);
+    };
+
+    // gives a bit mask of events (of an event list) for which a state itself is a source state of a transition
+    // of its parent state machine or of a cross-level transition
+    template<typename RootStateT, typename ParentStateT, typename StateT, typename... EventTs>
+    constexpr std::uint64_t own_subscription_mask()
+    {
+      using Transitions = typename ParentStateT::Transitions;
+      using Cross_transitions = cross_transitions_t<RootStateT>;
+
+      std::uint64_t mask = 0;
+      std::size_t bit = 0;
+      ((mask |= static_cast<std::uint64_t>(has_tr_w_src_state_event<StateT, EventTs, Transitions>::value ||
+        has_tr_w_src_state_event<StateT, EventTs, Cross_transitions>::value) << bit++), ...);
+      return mask;
+    }
+
+    // fills bit masks of events handled by configurations with states nested in a given state,
+    // i.e. handled by the nested state itself or by any of its ancestors
+    template<typename RootStateT, typename ParentStateT, typename MasksT, typename... EventTs>
+    struct Subscription_mask_filler {
+      using Nested_state_set = state_set_t<ParentStateT>;
+
+      template<std::size_t... Is>
+      static constexpr void fill(MasksT& masks, std::uint64_t parent_mask, std::index_sequence<Is...>)
+      {
+        (fill_nested<std::tuple_element_t<Is, Nested_state_set>>(masks, parent_mask), ...);
+      }
+
+      template<typename NestedStateT>
+      static constexpr void fill_nested(MasksT& masks, std::uint64_t parent_mask)
+      {
+        constexpr auto id = state_id_v<RootStateT, NestedStateT>;
+        masks[id] = parent_mask | own_subscription_mask<RootStateT, ParentStateT, NestedStateT, EventTs...>();
+
+        if constexpr (is_composite_state_v<NestedStateT>) {
+          Subscription_mask_filler<RootStateT, NestedStateT, MasksT, EventTs...>::fill(masks, masks[id],
+            std::make_index_sequence<std::tuple_size_v<state_set_t<NestedStateT>>>{});
+        }
+      }
+    };
+
+    // gives a table of bit masks of events (of an event list) handled by each configuration,
+    // indexed by global identifiers of innermost states
+    template<typename RootStateT, typename... EventTs>
+    struct Subscription_masks {
+      using Masks = std::array<std::uint64_t, state_count_v<RootStateT>>;
+
+      static constexpr Masks make()
+      {
+        Masks masks{};
+        Subscription_mask_filler<RootStateT, RootStateT, Masks, EventTs...>::fill(masks, 0,
+          std::make_index_sequence<std::tuple_size_v<state_set_t<RootStateT>>>{});
+        return masks;
+      }
+
+      static constexpr Masks table = make();
+    };
+  }
+
+  template<typename StateMachineT, typename... EventTs>
+  class Event_bus {
+  public:
+    static_assert(sizeof...(EventTs) > 0 && sizeof...(EventTs) <= 64, "Event type list must have 1..64 types");
+
+    class Member;
+
+    // a link of a member in a list of subscribers of a single event type
+    struct Link {
+      Link* prev = nullptr;
+      Link* next = nullptr;
+      Member* owner = nullptr;
+    };
+
+    // a state machine being a member of a bus
+    // NOTE: a member is linked into lists of the bus, so it cannot be copied nor moved
+    class Member {
+    public:
+      Member()
+      {
+        for (auto& link : links_) {
+          link.owner = this;
+        }
+      }
+
+      Member(const Member&) = delete;
+      Member& operator=(const Member&) = delete;
+
+      ~Member()
+      {
+        unsubscribe(subscriptions_);
+      }
+
+      // NOTE: the state machine can be accessed directly as long as its configuration is not changed
+      // other than through `react()` of the member while being a member of a bus
+      StateMachineT sm;
+
+      // passes an event directly to the member's state machine, updating its subscriptions
+      template<typename EventT>
+      bool react(EventT&& evt)
+      {
+        const bool handled = sm.react(std::forward<EventT>(evt));
+        if (bus_ != nullptr) {
+          resubscribe();
+        }
+        return handled;
+      }
+
+      // gives a bit mask of event types (indices within the event list of the bus) the member is subscribed to
+      std::uint64_t subscriptions() const
+      {
+        return subscriptions_;
+      }
+
+    private:
+      friend class Event_bus;
+
+      void resubscribe()
+      {
+        const std::uint64_t mask = subscription_mask_of(sm);
+        const std::uint64_t changed = mask ^ subscriptions_;
+
+        unsubscribe(changed & subscriptions_);
+        for (std::size_t idx = 0; idx < sizeof...(EventTs); ++idx) {
+          if ((changed & mask) & (std::uint64_t{1} << idx)) {
+            bus_->link(idx, links_[idx]);
+          }
+        }
+        subscriptions_ = mask;
+      }
+
+      void unsubscribe(std::uint64_t mask)
+      {
+        for (std::size_t idx = 0; idx < sizeof...(EventTs); ++idx) {
+          if (mask & (std::uint64_t{1} << idx)) {
+            unlink(links_[idx]);
+          }
+        }
+        subscriptions_ &= ~mask;
+      }
+
+      std::array<Link, sizeof...(EventTs)> links_;
+      std::uint64_t subscriptions_ = 0;
+      Event_bus* bus_ = nullptr;
+    };
+
+    // gives a bit mask of event types the current configuration of a state machine can handle
+    static std::uint64_t subscription_mask_of(const StateMachineT& sm)
+    {
+      return helpers::Subscription_masks<StateMachineT, EventTs...>::table[sm.current_leaf_id()];
+    }
+
+    template<typename EventT>
+    static constexpr std::size_t event_idx = utils::tuple_elem_idx_v<utils::remove_cvref_t<EventT>, std::tuple<EventTs...>>;
+
+    Event_bus()
+    {
+      for (auto& list : lists_) {
+        list.prev = list.next = &list;
+      }
+    }
+
+    Event_bus(const Event_bus&) = delete;
+    Event_bus& operator=(const Event_bus&) = delete;
+
+    ~Event_bus()
+    {
+      for (auto& list : lists_) {
+        while (list.next != &list) {
+          leave(*list.next->owner);
+        }
+      }
+    }
+
+    // adds a member to the bus; its state machine must be started
+    // NOTE: a member can only be a member of a single bus
+    void join(Member& member)
+    {
+      if (member.bus_ == nullptr) {
+        member.bus_ = this;
+        member.resubscribe();
+      }
+    }
+
+    void leave(Member& member)
+    {
+      if (member.bus_ == this) {
+        member.unsubscribe(member.subscriptions_);
+        member.bus_ = nullptr;
+      }
+    }
+
+    // dispatches an event to all members whose configuration can handle it; gives the number of members
+    // which handled the event
+    // NOTE: the event is passed to each member as an lvalue (it may not be moved from by a member);
+    // members must not publish to the bus nor join or leave it while handling the event
+    template<typename EventT>
+    std::size_t publish(const EventT& evt)
+    {
+      Link& list = lists_[event_idx<EventT>];
+      std::size_t count = 0;
+
+      for (Link* link = list.next; link != &list;) {
+        // NOTE: the member may unsubscribe from the event, so its successor is taken beforehand
+        Link* next = link->next;
+        count += link->owner->react(evt);
+        link = next;
+      }
+
+      return count;
+    }
+
+    // gives the number of members subscribed to an event type
+    template<typename EventT>
+    std::size_t subscriber_count() const
+    {
+      const Link& list = lists_[event_idx<EventT>];
+      std::size_t count = 0;
+      for (const Link* link = list.next; link != &list; link = link->next) {
+        ++count;
+      }
+      return count;
+    }
+
+  private:
+    void link(std::size_t idx, Link& link)
+    {
+      Link& list = lists_[idx];
+      link.prev = list.prev;
+      link.next = &list;
+      list.prev->next = &link;
+      list.prev = &link;
+    }
+
+    static void unlink(Link& link)
+    {
+      link.prev->next = link.next;
+      link.next->prev = link.prev;
+      link.prev = link.next = nullptr;
+    }
+
+    // each list is a circular list with a sentinel link
+    std::array<Link, sizeof...(EventTs)> lists_;
+  };
+}
+
+#endif
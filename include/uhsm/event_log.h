@@ -0,0 +1,155 @@
+#ifndef UHSM_EVENT_LOG_H_
+#define UHSM_EVENT_LOG_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "uhsm/utils.h"
+
+// NOTE: binary format of a recorded event stream; the stream starts with `Event_log::magic`
+// followed by records, each consisting of a 4-byte header (event type ID, payload size)
+// and the event object representation padded to a multiple of 4 bytes;
+// event type IDs are indices of event types in the event type list, so the list must be
+// the same for recording and replaying a stream
+
+namespace uhsm
+{
+  template<typename... EventTs>
+  struct Event_log {
+    static_assert(sizeof...(EventTs) > 0 && sizeof...(EventTs) <= 0xFFFF, "Event type list must have 1..65535 types");
+    static_assert(((std::is_trivially_copyable_v<EventTs> && std::is_default_constructible_v<EventTs>) && ...),
+      "Only trivially copyable, default constructible events can be recorded");
+    static_assert(((sizeof(EventTs) <= 0xFFFF) && ...), "Event size must not exceed 65535 bytes");
+
+    using Event_set = std::tuple<EventTs...>;
+
+    static constexpr std::array<char, 8> magic = {{'U', 'H', 'S', 'M', 'E', 'V', 'T', '1'}};
+    static constexpr std::size_t record_alignment = 4;
+
+    struct Record_header {
+      std::uint16_t type_id;
+      std::uint16_t size;
+    };
+    static_assert(sizeof(Record_header) == record_alignment);
+
+    template<typename EventT>
+    static constexpr std::uint16_t type_id = static_cast<std::uint16_t>(
+      utils::tuple_elem_idx_v<utils::remove_cvref_t<EventT>, Event_set>);
+
+    static constexpr std::size_t padded_size(std::size_t size)
+    {
+      return (size + record_alignment - 1) / record_alignment * record_alignment;
+    }
+
+    // serializes events with a writer callable as `write(const void* data, std::size_t size)`
+    template<typename WriterT>
+    class Recorder {
+    public:
+      explicit Recorder(WriterT writer) : writer_{std::move(writer)}
+      {
+        writer_(magic.data(), magic.size());
+      }
+
+      template<typename EventT>
+      void record(const EventT& evt)
+      {
+        static constexpr std::array<std::byte, record_alignment> padding{};
+        const Record_header header{type_id<EventT>, static_cast<std::uint16_t>(sizeof(EventT))};
+
+        writer_(&header, sizeof(header));
+        writer_(&evt, sizeof(EventT));
+        writer_(padding.data(), padded_size(sizeof(EventT)) - sizeof(EventT));
+      }
+
+      // records an event and passes it to a state machine
+      template<typename StateMachineT, typename EventT>
+      bool react(StateMachineT& sm, EventT&& evt)
+      {
+        record(evt);
+        return sm.react(std::forward<EventT>(evt));
+      }
+
+    private:
+      WriterT writer_;
+    };
+
+    // dispatches recorded events from a (memory-mapped) stream to a state machine;
+    // no memory is allocated and each record is restored with a single table lookup
+    template<typename StateMachineT>
+    class Reader {
+    public:
+      // NOTE: a stream without a valid magic is treated as empty
+      Reader(const void* data, std::size_t size)
+        : pos_{static_cast<const std::byte*>(data)}, end_{pos_ + size}
+      {
+        if (size < magic.size() || std::memcmp(pos_, magic.data(), magic.size()) != 0) {
+          pos_ = end_;
+        } else {
+          pos_ += magic.size();
+        }
+      }
+
+      // dispatches the next recorded event; returns false at the end of the stream
+      // or if the record is malformed
+      bool dispatch_next(StateMachineT& sm)
+      {
+        static constexpr Dispatch_fn dispatchers[] = {&dispatch<EventTs>...};
+        static constexpr std::uint16_t sizes[] = {static_cast<std::uint16_t>(sizeof(EventTs))...};
+
+        if (static_cast<std::size_t>(end_ - pos_) < sizeof(Record_header)) {
+          return false;
+        }
+
+        Record_header header;
+        std::memcpy(&header, pos_, sizeof(header));
+        const std::size_t record_size = sizeof(header) + padded_size(header.size);
+
+        if (header.type_id >= sizeof...(EventTs) || header.size != sizes[header.type_id] ||
+          static_cast<std::size_t>(end_ - pos_) < record_size) {
+          pos_ = end_;
+          return false;
+        }
+
+        dispatchers[header.type_id](sm, pos_ + sizeof(header));
+        pos_ += record_size;
+        return true;
+      }
+
+      bool at_end() const
+      {
+        return pos_ == end_;
+      }
+
+    private:
+      using Dispatch_fn = void (*)(StateMachineT&, const std::byte*);
+
+      template<typename EventT>
+      static void dispatch(StateMachineT& sm, const std::byte* payload)
+      {
+        EventT evt;
+        std::memcpy(&evt, payload, sizeof(EventT));
+        sm.react(std::move(evt));
+      }
+
+      const std::byte* pos_;
+      const std::byte* end_;
+    };
+  };
+
+  // Compile-time tests
+  ////////////////////////////////////////////////////////////////////////////////
+
+  namespace Test::EventLog_EventTypesPassed_ReturnTypeIdsAndPaddedSizes
+  {
+    using Log = Event_log<std::uint8_t, std::uint32_t, std::uint64_t>;
+
+    static_assert(Log::type_id<std::uint32_t> == 1);
+    static_assert(Log::type_id<const std::uint64_t&> == 2);
+    static_assert(Log::padded_size(1) == 4 && Log::padded_size(8) == 8);
+  }
+}
+
+#endif
@@ -0,0 +1,382 @@
+#ifndef UHSM_EVENT_QUEUE_H_
+#define UHSM_EVENT_QUEUE_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "uhsm/utils.h"
+
+// NOTE: a FIFO queue of events of heterogeneous types stored in a fixed-capacity ring arena;
+// each queued event occupies only its own size (rounded up to the arena alignment) plus a small
+// header holding the event type ID, so the memory used matches the actual mix of queued events
+// instead of sizing every slot for the largest event type; an event which does not fit
+// at the end of the arena is placed at its beginning (the gap is reclaimed once the reader
+// reaches it); no dynamic memory is allocated
+// NOTE: an event type declared as coalescable (`static constexpr bool coalesce = true;`) has at most
+// one pending event in a queue: pushing such an event while another one of the same type is pending
+// replaces (assigns) the pending one in place, which keeps its position in the queue; each coalescable
+// type has its own slot holding the offset of its pending event, so the lookup is O(1)
+
+namespace uhsm
+{
+  // checks if an event type is declared as coalescable by `static constexpr bool coalesce = true;`
+  template<typename EventT, typename = void>
+  struct is_coalescable : std::false_type {};
+  template<typename EventT>
+  struct is_coalescable<EventT, std::void_t<decltype(EventT::coalesce)>> : std::bool_constant<EventT::coalesce> {};
+  // helper variable template for `is_coalescable`
+  template<typename EventT>
+  inline constexpr bool is_coalescable_v = is_coalescable<utils::remove_cvref_t<EventT>>::value;
+  
+  template<std::size_t CapacityBytes, typename... EventTs>
+  class Event_queue {
+  public:
+    static_assert(sizeof...(EventTs) > 0 && sizeof...(EventTs) < 0xFFFF, "Event type list must have 1..65534 types");
+
+    using Event_set = std::tuple<EventTs...>;
+
+    static constexpr std::size_t alignment = std::max({alignof(std::uint16_t), alignof(EventTs)...});
+    static constexpr std::size_t header_size = alignment;
+
+    static_assert(CapacityBytes % alignment == 0, "Capacity must be a multiple of the alignment of queued events");
+
+    template<typename EventT>
+    static constexpr std::size_t record_size = header_size + (sizeof(EventT) + alignment - 1) / alignment * alignment;
+
+    static_assert(((record_size<EventTs> <= CapacityBytes) && ...), "Each event type must fit in the arena");
+
+    template<typename EventT>
+    static constexpr std::uint16_t type_id = static_cast<std::uint16_t>(
+      utils::tuple_elem_idx_v<utils::remove_cvref_t<EventT>, Event_set>);
+
+    static constexpr std::size_t coalescable_count = (std::size_t{is_coalescable_v<EventTs>} + ... + 0);
+
+    // gives an index of the pending event slot of a coalescable event type
+    template<typename EventT>
+    static constexpr std::size_t coalesce_slot()
+    {
+      constexpr bool coalescable[] = {is_coalescable_v<EventTs>...};
+      
+      std::size_t slot = 0;
+      for (std::size_t id = 0; id < type_id<EventT>; ++id) {
+        slot += coalescable[id];
+      }
+      return slot;
+    }
+
+    Event_queue()
+    {
+      pending_.fill(no_pending);
+    }
+
+    Event_queue(const Event_queue&) = delete;
+    Event_queue& operator=(const Event_queue&) = delete;
+
+    ~Event_queue()
+    {
+      clear();
+    }
+
+    // enqueues an event; returns false (and leaves the event intact) if there is not enough space
+    // NOTE: a coalescable event replaces a pending event of its type (if any), which always succeeds
+    template<typename EventT>
+    bool push(EventT&& evt)
+    {
+      using Event = utils::remove_cvref_t<EventT>;
+      constexpr std::size_t size = record_size<Event>;
+
+      if constexpr (is_coalescable_v<Event>) {
+        static_assert(std::is_assignable_v<Event&, EventT&&>, "Coalescable event type must be assignable");
+        auto& pending_offset = pending_[coalesce_slot<Event>()];
+        
+        if (pending_offset != no_pending) {
+          *std::launder(reinterpret_cast<Event*>(storage_ + pending_offset + header_size)) = std::forward<EventT>(evt);
+          return true;
+        }
+        // NOTE: the event is appended below, so its offset is the current write offset
+        // (after a possible wrap)
+        if (!append(std::forward<EventT>(evt))) {
+          return false;
+        }
+        pending_offset = (head_ + CapacityBytes - size) % CapacityBytes;
+        return true;
+      } else {
+        return append(std::forward<EventT>(evt));
+      }
+    }
+
+    // dequeues the oldest event and passes it (as an rvalue) to a state machine;
+    // returns false if the queue is empty
+    // NOTE: the event occupies the arena until `react()` returns, so it may enqueue further events
+    template<typename StateMachineT>
+    bool dispatch_one(StateMachineT& sm)
+    {
+      static constexpr Dispatch_fn<StateMachineT> dispatchers[] = {&dispatch<StateMachineT, EventTs>...};
+      static constexpr std::size_t sizes[] = {record_size<EventTs>...};
+
+      if (used_ == 0) {
+        return false;
+      }
+
+      const auto id = read_header(tail_);
+      // NOTE: a coalescable event being dispatched is not pending anymore; an event of the same type
+      // pushed by `react()` is queued as a new one
+      forget_pending(id);
+      dispatchers[id](sm, storage_ + tail_ + header_size);
+      release_front(sizes[id]);
+      return true;
+    }
+
+    // dispatches events until the queue is empty; gives the number of dispatched events
+    template<typename StateMachineT>
+    std::size_t dispatch_all(StateMachineT& sm)
+    {
+      std::size_t count = 0;
+      while (dispatch_one(sm)) {
+        ++count;
+      }
+      return count;
+    }
+
+    // destroys all queued events without dispatching them
+    void clear()
+    {
+      static constexpr Destroy_fn destroyers[] = {&destroy<EventTs>...};
+      static constexpr std::size_t sizes[] = {record_size<EventTs>...};
+
+      while (used_ != 0) {
+        const auto id = read_header(tail_);
+        forget_pending(id);
+        destroyers[id](storage_ + tail_ + header_size);
+        release_front(sizes[id]);
+      }
+    }
+
+    bool empty() const
+    {
+      return used_ == 0;
+    }
+
+    // gives the number of arena bytes occupied by queued events (including headers and wrap gaps)
+    std::size_t used_bytes() const
+    {
+      return used_;
+    }
+
+  private:
+    static constexpr std::uint16_t wrap_marker = 0xFFFF;
+    static constexpr std::size_t no_pending = ~std::size_t{0};
+
+    template<typename StateMachineT>
+    using Dispatch_fn = void (*)(StateMachineT&, std::byte*);
+    using Destroy_fn = void (*)(std::byte*);
+
+    template<typename EventT>
+    bool append(EventT&& evt)
+    {
+      using Event = utils::remove_cvref_t<EventT>;
+      constexpr std::size_t size = record_size<Event>;
+
+      if (used_ == 0) {
+        // NOTE: an empty arena is restarted from the beginning to avoid needless wrapping
+        head_ = tail_ = 0;
+      } else if (head_ == tail_) {
+        // the arena is full
+        return false;
+      }
+
+      if (head_ > tail_ || used_ == 0) {
+        if (CapacityBytes - head_ < size) {
+          // not enough space at the end of the arena; wrap if there is enough space at its beginning
+          if (tail_ < size) {
+            return false;
+          }
+          // NOTE: all offsets are multiples of the header size, so there is always space for the marker
+          write_header(head_, wrap_marker);
+          used_ += CapacityBytes - head_;
+          head_ = 0;
+        }
+      } else if (tail_ - head_ < size) {
+        return false;
+      }
+
+      write_header(head_, type_id<Event>);
+      ::new (static_cast<void*>(storage_ + head_ + header_size)) Event(std::forward<EventT>(evt));
+      head_ = (head_ + size) % CapacityBytes;
+      used_ += size;
+      return true;
+    }
+
+    // clears the pending event slot of a coalescable event type given by its type ID
+    void forget_pending(std::uint16_t id)
+    {
+      if constexpr (coalescable_count > 0) {
+        static constexpr std::size_t slots[] = {(is_coalescable_v<EventTs> ? coalesce_slot<EventTs>() : no_pending)...};
+        
+        if (slots[id] != no_pending) {
+          pending_[slots[id]] = no_pending;
+        }
+      }
+    }
+
+    template<typename StateMachineT, typename EventT>
+    static void dispatch(StateMachineT& sm, std::byte* payload)
+    {
+      auto& evt = *std::launder(reinterpret_cast<EventT*>(payload));
+      sm.react(std::move(evt));
+      evt.~EventT();
+    }
+
+    template<typename EventT>
+    static void destroy(std::byte* payload)
+    {
+      std::launder(reinterpret_cast<EventT*>(payload))->~EventT();
+    }
+
+    void write_header(std::size_t offset, std::uint16_t id)
+    {
+      ::new (static_cast<void*>(storage_ + offset)) std::uint16_t(id);
+    }
+
+    std::uint16_t read_header(std::size_t offset) const
+    {
+      return *std::launder(reinterpret_cast<const std::uint16_t*>(storage_ + offset));
+    }
+
+    // reclaims space of the oldest event; moves the reader to the beginning of the arena
+    // if the writer has wrapped at the new reader position
+    void release_front(std::size_t size)
+    {
+      tail_ = (tail_ + size) % CapacityBytes;
+      used_ -= size;
+
+      if (used_ != 0 && read_header(tail_) == wrap_marker) {
+        used_ -= CapacityBytes - tail_;
+        tail_ = 0;
+      }
+    }
+
+    alignas(alignment) std::byte storage_[CapacityBytes];
+    // write and read offsets within the arena
+    std::size_t head_ = 0;
+    std::size_t tail_ = 0;
+    std::size_t used_ = 0;
+    // offsets of pending events of coalescable event types
+    std::array<std::size_t, coalescable_count> pending_;
+  };
+
+  // gives a priority of an event type declared as `static constexpr unsigned priority = ...;`
+  // (0 - the lowest priority - if not declared)
+  template<typename EventT, typename = void>
+  struct event_priority {
+    static constexpr unsigned value = 0;
+  };
+  template<typename EventT>
+  struct event_priority<EventT, std::void_t<decltype(EventT::priority)>> {
+    static constexpr unsigned value = EventT::priority;
+  };
+  // helper variable template for `event_priority`
+  template<typename EventT>
+  inline constexpr unsigned event_priority_v = event_priority<utils::remove_cvref_t<EventT>>::value;
+
+  // NOTE: a queue of events bound to a state machine, with a separate FIFO arena (of `LevelCapacityBytes`)
+  // for each priority level; events of the highest pending priority are always dispatched first;
+  // non-empty levels are tracked in a bitmap, so the highest pending level is found with a single
+  // count-leading-zeros instruction regardless of the number of queued events
+  template<typename StateMachineT, std::size_t LevelCapacityBytes, typename... EventTs>
+  class Priority_event_queue {
+  public:
+    static constexpr unsigned level_count = std::max({event_priority_v<EventTs>...}) + 1;
+    static_assert(level_count <= 32, "Event priority must be lower than 32");
+
+    explicit Priority_event_queue(StateMachineT& sm) : sm_{sm} {}
+
+    // enqueues an event at the level of its priority; returns false if the level is full
+    template<typename EventT>
+    bool push(EventT&& evt)
+    {
+      constexpr unsigned level = event_priority_v<EventT>;
+
+      if (!levels_[level].push(std::forward<EventT>(evt))) {
+        return false;
+      }
+
+      pending_ |= std::uint32_t{1} << level;
+      return true;
+    }
+
+    // dispatches the oldest event of the highest pending priority; returns false if the queue is empty
+    bool dispatch_one()
+    {
+      if (pending_ == 0) {
+        return false;
+      }
+
+      const unsigned level = utils::highest_bit_idx(pending_);
+      levels_[level].dispatch_one(sm_);
+
+      // NOTE: the dispatched event may have enqueued further events at the same level
+      if (levels_[level].empty()) {
+        pending_ &= ~(std::uint32_t{1} << level);
+      }
+
+      return true;
+    }
+
+    // dispatches events until the queue is empty; gives the number of dispatched events
+    std::size_t dispatch_all()
+    {
+      std::size_t count = 0;
+      while (dispatch_one()) {
+        ++count;
+      }
+      return count;
+    }
+
+    bool empty() const
+    {
+      return pending_ == 0;
+    }
+
+  private:
+    StateMachineT& sm_;
+    std::array<Event_queue<LevelCapacityBytes, EventTs...>, level_count> levels_;
+    // bit N is set if there are events of priority N
+    std::uint32_t pending_ = 0;
+  };
+
+  // Compile-time tests
+  ////////////////////////////////////////////////////////////////////////////////
+
+  namespace Test::EventPriority_PriorityDeclared_ReturnPriority
+  {
+    struct Data {};
+    struct Fault {
+      static constexpr unsigned priority = 7;
+    };
+
+    static_assert(event_priority_v<Data> == 0);
+    static_assert(event_priority_v<const Fault&> == 7);
+  }
+  
+  namespace Test::EventQueueCoalesceSlot_CoalescableTypesPassed_ReturnSlotIdx
+  {
+    struct Data {};
+    struct Progress {
+      static constexpr bool coalesce = true;
+    };
+    struct Level {
+      static constexpr bool coalesce = true;
+    };
+    using Queue = Event_queue<64, Progress, Data, Level>;
+
+    static_assert(Queue::coalescable_count == 2);
+    static_assert(Queue::coalesce_slot<Progress>() == 0 && Queue::coalesce_slot<Level>() == 1);
+  }
+}
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef UHSM_FLAT_DISPATCH_H_
+#define UHSM_FLAT_DISPATCH_H_
+
+#include <array>
+#include <cstddef>
+#include "uhsm/helpers.h"
+#include "uhsm/cross_transition.h"
+
+// NOTE: an alternative implementation of the base algorithm of a hierarchical state machine
+// optimized for speed; the whole state hierarchy is flattened at compile time into a table
+// of cells (current innermost state x event type); each cell resolves (at compile time) which
+// hierarchy level handles the event, the dest. state and the exact sequence of exited and entered
+// states, so processing an event is a single table lookup followed by a straight-line sequence
+// of hook invocations regardless of the nesting depth
+
+namespace uhsm::helpers
+{
+  // gives an index of the first cross-level transition triggered by an event whose source state
+  // is on a path (or the size of the table if there is none)
+  template<typename PathT, typename EventT, typename... TransitionTs>
+  constexpr std::size_t find_cross_tr_idx(std::tuple<TransitionTs...>*)
+  {
+    constexpr bool matches[] = {(utils::contains_t<get_tr_src_state<TransitionTs>, PathT>::value &&
+      std::is_same_v<get_tr_event<TransitionTs>, EventT>)..., false};
+
+    for (std::size_t i = 0; i < sizeof...(TransitionTs); ++i) {
+      if (matches[i]) {
+        return i;
+      }
+    }
+
+    return sizeof...(TransitionTs);
+  }
+
+  // processing of a single event type while a given innermost state is current
+  template<typename RootStateT, typename EventT, typename LeafStateT>
+  struct Flat_cell {
+    using Event = utils::remove_cvref_t<EventT>;
+    using Path = state_path_t<RootStateT, LeafStateT>;
+    // states on the path including the topmost state machine (at depth 0)
+    using Full_path = utils::prepend_t<RootStateT, Path>;
+    static constexpr std::size_t leaf_depth = std::tuple_size_v<Path>;
+
+    template<std::size_t Depth>
+    using State_at = std::tuple_element_t<Depth, Full_path>;
+
+    // finds the innermost hierarchy level with a transition triggered by the event whose source
+    // state is on the path; gives depth of the source state (or 0 if there is none)
+    template<std::size_t Depth>
+    static constexpr std::size_t find_src_depth()
+    {
+      if constexpr (Depth == 0) {
+        return 0;
+      } else {
+        using Transitions = typename State_at<Depth - 1>::Transitions;
+        if constexpr (find_tr_idx<State_at<Depth>, Event>(static_cast<Transitions*>(nullptr)) <
+          std::tuple_size_v<Transitions>) {
+          return Depth;
+        } else {
+          return find_src_depth<Depth - 1>();
+        }
+      }
+    }
+
+    static constexpr std::size_t src_depth = find_src_depth<leaf_depth>();
+
+    // NOTE: cross-level transitions are only considered if no regular transition handles the event
+    static constexpr std::size_t cross_tr_idx = find_cross_tr_idx<Path, Event>(
+      static_cast<cross_transitions_t<RootStateT>*>(nullptr));
+    static constexpr bool handles_event = src_depth > 0 ||
+      cross_tr_idx < std::tuple_size_v<cross_transitions_t<RootStateT>>;
+
+    // invokes on_exit on states on the path from the innermost state up to a given depth
+    template<std::size_t Depth, std::size_t LastDepth>
+    static constexpr void exit_path(RootStateT& root, const Event& evt)
+    {
+      invoke_on_exit(get_on_path<Path, Depth>(root), evt, root);
+
+      if constexpr (Depth > LastDepth) {
+        exit_path<Depth - 1, LastDepth>(root, evt);
+      }
+    }
+
+    static bool execute(RootStateT& root, EventT&& evt)
+    {
+      if constexpr (src_depth == 0) {
+        using Transition = std::tuple_element_t<cross_tr_idx, cross_transitions_t<RootStateT>>;
+        Cross_transition<RootStateT, Transition>::execute(root, std::forward<EventT>(evt));
+      } else {
+        using Level = State_at<src_depth - 1>;
+        using Transitions = typename Level::Transitions;
+        static_assert(!has_ambiguous_trs_v<Transitions>, "Transition table may not have ambiguous transitions");
+
+        using Transition = std::tuple_element_t<find_tr_idx<State_at<src_depth>, Event>(
+          static_cast<Transitions*>(nullptr)), Transitions>;
+        using Dest_state = get_tr_dest_state<Transition>;
+
+        auto& level = get_on_path<Path, src_depth - 1>(root);
+        auto& src_state = *std::get_if<State_at<src_depth>>(&level.state_data);
+
+        if constexpr (std::is_same_v<State_at<src_depth>, Dest_state>) {
+          // internal transition; do not call on_entry/on_exit
+          Action_invocation<Transition>::invoke(src_state, std::forward<EventT>(evt), root);
+        } else {
+          Action_invocation<Transition>::invoke(src_state, std::as_const(evt), root);
+
+          if constexpr (!is_elided_exit_cascade_v<State_at<src_depth>, RootStateT, Event>) {
+            exit_path<leaf_depth, src_depth>(root, evt);
+          }
+          enter_dest_state<get_state_idx_v<Dest_state, state_set_t<Level>>>(
+            level.state_data, std::forward<EventT>(evt), root);
+          update_active_leaf(root, initial_leaf_id_v<RootStateT, Dest_state>);
+        }
+      }
+
+      return true;
+    }
+  };
+
+  // dispatches an event with a single lookup in a table indexed by the identifier of the current
+  // innermost state
+  template<typename RootStateT, typename EventT>
+  struct Flat_dispatcher {
+    using Cell_fn = bool (*)(RootStateT&, EventT&&);
+    using States = nested_states_t<RootStateT>;
+
+    static bool ignore(RootStateT&, EventT&&)
+    {
+      return false;
+    }
+
+    template<std::size_t I>
+    static constexpr Cell_fn get_cell()
+    {
+      using State = std::tuple_element_t<I, States>;
+
+      // NOTE: composite states are never the current innermost state
+      if constexpr (is_composite_state_v<State>) {
+        return &ignore;
+      } else if constexpr (Flat_cell<RootStateT, EventT, State>::handles_event) {
+        return &Flat_cell<RootStateT, EventT, State>::execute;
+      } else {
+        return &ignore;
+      }
+    }
+
+    template<std::size_t... Is>
+    static constexpr auto make_cell_table(std::index_sequence<Is...>)
+    {
+      return std::array<Cell_fn, sizeof...(Is)>{{get_cell<Is>()...}};
+    }
+
+    static bool dispatch(RootStateT& root, EventT&& evt)
+    {
+      static constexpr auto cells = make_cell_table(std::make_index_sequence<state_count_v<RootStateT>>{});
+      return cells[root.private_active_leaf_id](root, std::forward<EventT>(evt));
+    }
+  };
+}
+
+#endif
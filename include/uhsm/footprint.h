@@ -0,0 +1,128 @@
+#ifndef UHSM_FOOTPRINT_H_
+#define UHSM_FOOTPRINT_H_
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include "uhsm/helpers.h"
+
+// NOTE: compile-time introspection of the storage footprint of a state machine; the state data of each
+// hierarchy level is a variant sized to its largest alternative and nested state machines are stored
+// inline within their parent's alternative, so a single member added to a deeply nested state may grow
+// every instance of the whole state machine; the report tells which states and levels are responsible
+// NOTE: all of the reported values are compile-time constants, so they can be checked by `static_assert`;
+// a budget of the whole state machine can be declared directly on it (see `storage_budget` in README)
+
+namespace uhsm
+{
+  // storage footprint of a single state (including all of its nested states)
+  struct State_footprint {
+    std::size_t size;
+    std::size_t align;
+    // size of the variant holding the current nested state (0 for a simple state)
+    std::size_t state_data_size;
+    // size of the largest nested state (0 for a simple state); the rest of `state_data_size`
+    // is the variant's discriminator and padding
+    std::size_t largest_nested_size;
+  };
+
+  namespace helpers
+  {
+    // gives an index of the largest type of a tuple (the first one if there are more of them)
+    template<typename TupleT>
+    struct largest_type_idx;
+    template<typename... Ts>
+    struct largest_type_idx<std::tuple<Ts...>> {
+      static constexpr std::size_t find()
+      {
+        constexpr std::size_t sizes[] = {sizeof(Ts)...};
+
+        std::size_t largest_idx = 0;
+        for (std::size_t idx = 1; idx < sizeof...(Ts); ++idx) {
+          if (sizes[idx] > sizes[largest_idx]) {
+            largest_idx = idx;
+          }
+        }
+        return largest_idx;
+      }
+
+      static constexpr std::size_t value = find();
+    };
+
+    // gives the path of states from a given state to a simple state choosing the largest nested state
+    // at each hierarchy level, i.e. the states which determine the size of the given state
+    template<typename StateT, typename = void>
+    struct largest_path {
+      using type = std::tuple<StateT>;
+    };
+    template<typename StateT>
+    struct largest_path<StateT, std::enable_if_t<is_composite_state_v<StateT>>> {
+      using Nested_state_set = state_set_t<StateT>;
+      using Largest_nested_state = std::tuple_element_t<largest_type_idx<Nested_state_set>::value, Nested_state_set>;
+      using Nested_path = typename largest_path<Largest_nested_state>::type;
+      using type = utils::prepend_t<StateT, Nested_path>;
+    };
+    // helper typedef for `largest_path`
+    template<typename StateT>
+    using largest_path_t = typename largest_path<StateT>::type;
+  }
+
+  // gives the storage footprint of a state
+  template<typename StateT>
+  constexpr State_footprint footprint_of()
+  {
+    if constexpr (helpers::is_composite_state_v<StateT>) {
+      using Nested_state_set = helpers::state_set_t<StateT>;
+      using Largest_nested_state = std::tuple_element_t<
+        helpers::largest_type_idx<Nested_state_set>::value, Nested_state_set>;
+
+      return {sizeof(StateT), alignof(StateT), sizeof(StateT::state_data), sizeof(Largest_nested_state)};
+    } else {
+      return {sizeof(StateT), alignof(StateT), 0, 0};
+    }
+  }
+
+  namespace helpers
+  {
+    template<typename StateSetT>
+    struct Footprint_table;
+    template<typename... StateTs>
+    struct Footprint_table<std::tuple<StateTs...>> {
+      static constexpr std::array<State_footprint, sizeof...(StateTs)> footprints = {{footprint_of<StateTs>()...}};
+
+      template<typename RootStateT>
+      static constexpr std::array<State_id, sizeof...(StateTs)> ids = {{state_id_v<RootStateT, StateTs>...}};
+    };
+  }
+
+  // storage footprint report of the topmost state machine
+  template<typename RootStateT>
+  struct Footprint_report {
+    // footprint of the whole state machine
+    static constexpr State_footprint root = footprint_of<RootStateT>();
+
+    // footprints of all nested states indexed by their global identifiers (see `state_id_v`)
+    static constexpr auto states = helpers::Footprint_table<helpers::nested_states_t<RootStateT>>::footprints;
+
+    // nested states on the path determining the size of the state machine (see `largest_path`)
+    using Largest_path = helpers::largest_path_t<RootStateT>;
+    // global identifiers of the nested states on the largest path
+    static constexpr auto largest_path_ids = helpers::Footprint_table<
+      typename helpers::largest_path<RootStateT>::Nested_path>::template ids<RootStateT>;
+  };
+
+  // Compile-time tests
+  ////////////////////////////////////////////////////////////////////////////////
+
+  namespace Test::LargestTypeIdx_TuplePassed_ReturnFirstLargestIdx
+  {
+    struct A { char data[2]; };
+    struct B { char data[4]; };
+    struct C { char data[4]; };
+
+    static_assert(helpers::largest_type_idx<std::tuple<A, B, C>>::value == 1);
+    static_assert(helpers::largest_type_idx<std::tuple<A>>::value == 0);
+  }
+}
+
+#endif
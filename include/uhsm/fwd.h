@@ -12,9 +12,35 @@ namespace uhsm
   template<typename... TransitionsT>
   using Transition_table = std::tuple<TransitionsT...>;
     
+  // implementations of the base algorithm of a hierarchical state machine
+  enum class Dispatch_mode {
+    // nested chains of comparisons inlined for each hierarchy level and event type (default)
+    inlined,
+    // transition tables encoded as constant byte arrays searched by a single shared function
+    compact,
+    // whole hierarchy flattened into a table of (innermost state x event) cells
+    flat,
+    // active path walked in a loop over tables indexed by state identifiers; stack depth
+    // independent of the nesting depth
+    iterative
+  };
+  
+  // kinds of invocations measured by a profiler of a state machine
+  enum class Profiled_hook {
+    entry,
+    exit,
+    action,
+    // whole `react()` call of the topmost state machine
+    react
+  };
+  
+  // returned by default (empty) on_entry/on_exit hooks, so that they can be told apart from hooks
+  // declared by states and elided at compile time
+  struct Default_hook {};
+  
   struct Empty_action {
     template<typename SrcStateT, typename EventT>
-    void operator()(const SrcStateT&, EventT&&) {}
+    constexpr void operator()(const SrcStateT&, EventT&&) {}
   };
 }
 
@@ -1,6 +1,7 @@
 #ifndef UHSM_HELPERS_H_
 #define UHSM_HELPERS_H_
 
+#include <cstdint>
 #include <limits>
 #include "uhsm/utils.h"
 
@@ -65,20 +66,28 @@ namespace uhsm::helpers
   template<typename TransitionTableT>
   using extract_state_set_t = typename extract_state_set<TransitionTableT>::type;
   
-  // gets index of a state in a set of state (tuple)
-  template<size_t N, typename MatchStateT, typename StateSetT>
-  struct get_state_idx_impl;
-  template<size_t N, typename MatchStateT, typename... TailStateTs>
-  struct get_state_idx_impl<N, MatchStateT, std::tuple<MatchStateT, TailStateTs...>>  {
-    static constexpr size_t value = N;
+  // gives a set of (direct) nested states of a state machine; a precomputed set (e.g. emitted by
+  // a code generator) can be declared as `using State_list = std::tuple<...>;` and must list
+  // the states in the order given by `extract_state_set_t` (of their last appearance as a source state)
+  template<typename StateT, typename = void>
+  struct state_set {
+    using type = extract_state_set_t<typename StateT::Transitions>;
   };
-  template<size_t N, typename MatchStateT, typename HeadStateT, typename... TailStateTs>
-  struct get_state_idx_impl<N, MatchStateT, std::tuple<HeadStateT, TailStateTs...>> {
-    static constexpr size_t value = get_state_idx_impl<N + 1, MatchStateT, std::tuple<TailStateTs...>>::value;
+  template<typename StateT>
+  struct state_set<StateT, std::void_t<typename StateT::State_list>> {
+    // NOTE: states are entered and looked up by their index within the set, so a reordered or stale list
+    // would silently select wrong alternatives of the state data
+    static_assert(std::is_same_v<utils::variant_from_tuple_ts<typename StateT::State_list>, decltype(StateT::state_data)>,
+      "State_list must list the alternatives of state_data in the same order");
+    using type = typename StateT::State_list;
   };
-  // helper variable template for `get_state_idx_impl`
+  // helper typedef for `state_set`
+  template<typename StateT>
+  using state_set_t = typename state_set<StateT>::type;
+  
+  // gets index of a state in a set of state (tuple)
   template<typename MatchStateT, typename StateSetT>
-  inline constexpr size_t get_state_idx_v = get_state_idx_impl<0, MatchStateT, StateSetT>::value;
+  inline constexpr size_t get_state_idx_v = utils::tuple_elem_idx_v<MatchStateT, StateSetT>;
   
   // transition element getters
   template<typename TransitionT>
@@ -97,30 +106,472 @@ namespace uhsm::helpers
   template<typename StateSetT, typename TransitionT>
   inline constexpr size_t get_tr_dest_state_idx_v = get_state_idx_v<get_tr_dest_state<TransitionT>, StateSetT>;
 
+  // extracts a set of (unique) events triggering transitions from a transition table
+  template<typename TransitionTableT>
+  struct extract_event_set;
+  template<typename... TransitionTs>
+  struct extract_event_set<uhsm::Transition_table<TransitionTs...>> {
+    using type = utils::remove_duplicates_t<std::tuple<get_tr_event<TransitionTs>...>>;
+  };
+  // helper typedef for `extract_event_set`
+  template<typename TransitionTableT>
+  using extract_event_set_t = typename extract_event_set<TransitionTableT>::type;
+  
+  // checks if a state is a substate machine (has its own set of nested states), as opposed to a simple state
+  template<typename StateT, typename = void>
+  struct is_composite_state : std::false_type {};
+  template<typename StateT>
+  struct is_composite_state<StateT, std::void_t<typename StateT::template State_set<StateT>>> : std::true_type {};
+  // helper variable template for `is_composite_state`
+  template<typename StateT>
+  inline constexpr bool is_composite_state_v = is_composite_state<StateT>::value;
+  
+  // checks if a transition table contains at least one transition triggered by a given event
+  template<typename EventT, typename TransitionTableT>
+  struct has_tr_w_event;
+  template<typename EventT, typename... TransitionTs>
+  struct has_tr_w_event<EventT, uhsm::Transition_table<TransitionTs...>> {
+    static constexpr bool value = (std::is_same_v<get_tr_event<TransitionTs>, EventT> || ...);
+  };
+  // helper variable template for `has_tr_w_event`
+  template<typename EventT, typename TransitionTableT>
+  inline constexpr bool has_tr_w_event_v = has_tr_w_event<EventT, TransitionTableT>::value;
+  
+  // checks if a transition table contains a transition triggered by a given event leading to a given state
+  // from another state (i.e. the state may be entered as the destination state due to the event)
+  template<typename StateT, typename EventT, typename TransitionTableT>
+  struct has_tr_to_dest_state;
+  template<typename StateT, typename EventT, typename... TransitionTs>
+  struct has_tr_to_dest_state<StateT, EventT, uhsm::Transition_table<TransitionTs...>> {
+    static constexpr bool value = ((std::is_same_v<get_tr_event<TransitionTs>, EventT> &&
+      std::is_same_v<get_tr_dest_state<TransitionTs>, StateT> &&
+      !std::is_same_v<get_tr_src_state<TransitionTs>, StateT>) || ...);
+  };
+  // helper variable template for `has_tr_to_dest_state`
+  template<typename StateT, typename EventT, typename TransitionTableT>
+  inline constexpr bool has_tr_to_dest_state_v = has_tr_to_dest_state<StateT, EventT, TransitionTableT>::value;
+  
+  // checks if an event can be handled anywhere within the state hierarchy rooted at a given state;
+  // an event can never be handled within a simple state
+  template<typename StateT, typename EventT, typename = void>
+  struct handles_event : std::false_type {};
+  // a substate machine handles an event if its own transition table or any of its nested states does
+  template<typename StateT, typename EventT>
+  struct handles_event<StateT, EventT, std::enable_if_t<is_composite_state_v<StateT>>> {
+    template<typename NestedStateT>
+    using Nested_handles_event = handles_event<NestedStateT, EventT>;
+    
+    static constexpr bool value = has_tr_w_event_v<EventT, typename StateT::Transitions> ||
+      utils::any_of_v<Nested_handles_event, typename StateT::template State_set<StateT>>;
+  };
+  // helper variable template for `handles_event`; event type is taken without cv-qualifiers and references
+  template<typename StateT, typename EventT>
+  inline constexpr bool handles_event_v = handles_event<StateT, utils::remove_cvref_t<EventT>>::value;
+  
+  // gives the dispatch implementation selected by the topmost state machine by defining
+  // `static constexpr auto dispatch_mode = uhsm::Dispatch_mode::...;`
+  template<typename RootStateT, typename = void>
+  struct dispatch_mode {
+    static constexpr auto value = Dispatch_mode::inlined;
+  };
+  template<typename RootStateT>
+  struct dispatch_mode<RootStateT, std::void_t<decltype(RootStateT::dispatch_mode)>> {
+    static constexpr Dispatch_mode value = RootStateT::dispatch_mode;
+  };
+  // helper variable template for `dispatch_mode`
+  template<typename RootStateT>
+  inline constexpr Dispatch_mode dispatch_mode_v = dispatch_mode<RootStateT>::value;
+  
+  // checks if a state machine opted in for rejecting (at compile time) events it cannot handle
+  // by defining `static constexpr bool reject_unhandled_events = true;`
+  template<typename StateT, typename = void>
+  struct rejects_unhandled_events : std::false_type {};
+  template<typename StateT>
+  struct rejects_unhandled_events<StateT, std::void_t<decltype(StateT::reject_unhandled_events)>>
+    : std::bool_constant<StateT::reject_unhandled_events> {};
+  // helper variable template for `rejects_unhandled_events`
+  template<typename StateT>
+  inline constexpr bool rejects_unhandled_events_v = rejects_unhandled_events<StateT>::value;
+
+  // checks if the topmost state machine fits into the storage budget it declares by defining
+  // `static constexpr std::size_t storage_budget = N;` (in bytes); always true if no budget is declared
+  template<typename StateT, typename = void>
+  struct within_storage_budget : std::true_type {};
+  template<typename StateT>
+  struct within_storage_budget<StateT, std::void_t<decltype(StateT::storage_budget)>>
+    : std::bool_constant<sizeof(StateT) <= StateT::storage_budget> {};
+  
+  // fails the build if a state machine exceeds its storage budget
+  // NOTE: the size and the budget are template arguments, so they are shown by the compiler's diagnostic
+  template<std::size_t Size, std::size_t Budget>
+  struct Storage_budget_check {
+    static_assert(Size <= Budget, "State machine exceeds its storage budget (Size > Budget)");
+    static constexpr bool value = Size <= Budget;
+  };
+  template<typename StateT, typename = void>
+  struct check_storage_budget : std::true_type {};
+  template<typename StateT>
+  struct check_storage_budget<StateT, std::void_t<decltype(StateT::storage_budget)>>
+    : std::bool_constant<Storage_budget_check<sizeof(StateT), StateT::storage_budget>::value> {};
+  
+  // checks if the topmost state machine is profiled, i.e. declares a `profiler` data member
+  // (see `uhsm::Profiler`); hooks of a state machine which is not profiled are invoked directly
+  template<typename RootStateT, typename = void>
+  struct is_profiled : std::false_type {};
+  template<typename RootStateT>
+  struct is_profiled<RootStateT, std::void_t<decltype(std::declval<RootStateT&>().profiler)>> : std::true_type {};
+  // helper variable template for `is_profiled`
+  template<typename RootStateT>
+  inline constexpr bool is_profiled_v = is_profiled<RootStateT>::value;
+  
+  // checks if the topmost state machine publishes its configuration to other threads, i.e. it declares
+  // a `published_configuration` data member (see `uhsm::Published_configuration`)
+  template<typename RootStateT, typename = void>
+  struct is_published : std::false_type {};
+  template<typename RootStateT>
+  struct is_published<RootStateT, std::void_t<decltype(std::declval<RootStateT&>().published_configuration)>>
+    : std::true_type {};
+  // helper variable template for `is_published`
+  template<typename RootStateT>
+  inline constexpr bool is_published_v = is_published<RootStateT>::value;
+  
+  // NOTE: every state within the hierarchy of the topmost state machine is assigned a global identifier
+  // (known at compile time); states are numbered in depth-first pre-order, so all states nested
+  // (directly or indirectly) in a state have consecutive identifiers following the identifier of that state;
+  // the topmost state machine keeps the identifier of the current innermost (leaf) state, which determines
+  // the whole current configuration
+  
+  // global identifier of a state within the hierarchy of the topmost state machine
+  using State_id = std::uint16_t;
+  
+  // checks if a state machine declares a precomputed list of all of its nested states
+  // as `using Nested_state_list = std::tuple<...>;` (in depth-first, pre-order)
+  template<typename StateT, typename = void>
+  struct has_nested_state_list : std::false_type {};
+  template<typename StateT>
+  struct has_nested_state_list<StateT, std::void_t<typename StateT::Nested_state_list>> : std::true_type {};
+  
+  // gives a (depth-first, pre-order) list of all states nested in a given state
+  template<typename StateT, typename = void>
+  struct nested_states {
+    using type = std::tuple<>;
+  };
+  template<typename StateT>
+  struct nested_states<StateT, std::enable_if_t<has_nested_state_list<StateT>::value>> {
+    using type = typename StateT::Nested_state_list;
+  };
+  template<typename StateT>
+  struct nested_states<StateT, std::enable_if_t<is_composite_state_v<StateT> && !has_nested_state_list<StateT>::value>> {
+    template<typename... NestedStateTs>
+    static auto flatten(std::tuple<NestedStateTs...>) -> utils::concat_t<
+      utils::prepend_t<NestedStateTs, typename nested_states<NestedStateTs>::type>...>;
+      
+    using type = decltype(flatten(std::declval<typename StateT::template State_set<StateT>>()));
+  };
+  // helper typedef for `nested_states`
+  template<typename StateT>
+  using nested_states_t = typename nested_states<StateT>::type;
+  
+  // total number of states within the hierarchy of the topmost state machine
+  template<typename RootStateT>
+  inline constexpr std::size_t state_count_v = std::tuple_size_v<nested_states_t<RootStateT>>;
+  
+  // gives a global identifier of a state
+  template<typename RootStateT, typename StateT>
+  inline constexpr State_id state_id_v = static_cast<State_id>(
+    utils::tuple_elem_idx_v<StateT, nested_states_t<RootStateT>>);
+  
+  // gives a number of global identifiers occupied by a state and all of its nested states
+  template<typename StateT>
+  inline constexpr State_id subtree_size_v = static_cast<State_id>(1 + std::tuple_size_v<nested_states_t<StateT>>);
+  
+  // gives a cross-level transition table of the topmost state machine (empty if not declared)
+  template<typename RootStateT, typename = void>
+  struct cross_transitions {
+    using type = std::tuple<>;
+  };
+  template<typename RootStateT>
+  struct cross_transitions<RootStateT, std::void_t<typename RootStateT::Cross_transitions>> {
+    using type = typename RootStateT::Cross_transitions;
+  };
+  // helper typedef for `cross_transitions`
+  template<typename RootStateT>
+  using cross_transitions_t = typename cross_transitions<RootStateT>::type;
+  
+  // gives a transition table of a state (empty for a simple state)
+  template<typename StateT, typename = void>
+  struct level_transitions {
+    using type = std::tuple<>;
+  };
+  template<typename StateT>
+  struct level_transitions<StateT, std::enable_if_t<is_composite_state_v<StateT>>> {
+    using type = typename StateT::Transitions;
+  };
+  
+  // gives all transitions within the hierarchy of the topmost state machine: transition tables of the topmost
+  // state machine and of its nested state machines (in depth-first, pre-order) followed by cross-level transitions
+  template<typename RootStateT, typename StatesT = nested_states_t<RootStateT>>
+  struct all_transitions;
+  template<typename RootStateT, typename... StateTs>
+  struct all_transitions<RootStateT, std::tuple<StateTs...>> {
+    using type = utils::concat_t<typename RootStateT::Transitions, typename level_transitions<StateTs>::type...,
+      cross_transitions_t<RootStateT>>;
+  };
+  // helper typedef for `all_transitions`
+  template<typename RootStateT>
+  using all_transitions_t = typename all_transitions<RootStateT>::type;
+  
+  // total number of transitions within the hierarchy of the topmost state machine
+  template<typename RootStateT>
+  inline constexpr std::size_t transition_count_v = std::tuple_size_v<all_transitions_t<RootStateT>>;
+  
+  // gives a global identifier of a transition (its index within `all_transitions_t`)
+  // NOTE: a cross-level transition identical to a regular one (the same source and dest. state, event
+  // and action) shares its identifier
+  template<typename RootStateT, typename TransitionT>
+  inline constexpr State_id transition_id_v = static_cast<State_id>(
+    utils::tuple_elem_idx_v<TransitionT, all_transitions_t<RootStateT>>);
+  
+  // gives an index of the first transition with given source state and event in a transition table
+  // (or the size of the table if there is none)
+  template<typename SrcStateT, typename EventT, typename... TransitionTs>
+  constexpr std::size_t find_tr_idx(std::tuple<TransitionTs...>*)
+  {
+    constexpr bool matches[] = {(std::is_same_v<get_tr_src_state<TransitionTs>, SrcStateT> &&
+      std::is_same_v<get_tr_event<TransitionTs>, EventT>)..., false};
+  
+    for (std::size_t i = 0; i < sizeof...(TransitionTs); ++i) {
+      if (matches[i]) {
+        return i;
+      }
+    }
+  
+    return sizeof...(TransitionTs);
+  }
+  
+  // gives a global identifier of the innermost state which becomes current when a given state is entered
+  // (following initial states at each nested hierarchy level)
+  template<typename RootStateT, typename StateT, typename = void>
+  struct initial_leaf_id {
+    static constexpr State_id value = state_id_v<RootStateT, StateT>;
+  };
+  template<typename RootStateT, typename StateT>
+  struct initial_leaf_id<RootStateT, StateT, std::enable_if_t<is_composite_state_v<StateT>>> {
+    static constexpr State_id value = initial_leaf_id<RootStateT, typename StateT::Initial>::value;
+  };
+  // helper variable template for `initial_leaf_id`
+  template<typename RootStateT, typename StateT>
+  inline constexpr State_id initial_leaf_id_v = initial_leaf_id<RootStateT, StateT>::value;
+  
+  // gives a table mapping an index of a (nested) state within a state machine to the global identifier
+  // of the innermost state which becomes current when the nested state is entered
+  template<typename RootStateT, typename StateSetT>
+  struct Initial_leaf_ids;
+  template<typename RootStateT, typename... NestedStateTs>
+  struct Initial_leaf_ids<RootStateT, std::tuple<NestedStateTs...>> {
+    static constexpr State_id table[] = {initial_leaf_id_v<RootStateT, NestedStateTs>...};
+  };
+  
+  // checks if a state is the topmost state machine
+  template<typename StateT>
+  inline constexpr bool is_root_state_v = std::is_same_v<typename StateT::Parent, uhsm::No_parent_state>;
+  
+  // checks if a state is current given the identifier of the current innermost state
+  template<typename RootStateT, typename StateT>
+  constexpr bool is_in_subtree(State_id leaf_id)
+  {
+    return static_cast<State_id>(leaf_id - state_id_v<RootStateT, StateT>) < subtree_size_v<StateT>;
+  }
+  
+  // stores the identifier of the current innermost state in the topmost state machine
+  template<typename RootStateT>
+  constexpr void update_active_leaf(RootStateT& root, State_id leaf_id)
+  {
+    if constexpr (is_root_state_v<RootStateT>) {
+      root.private_active_leaf_id = leaf_id;
+      
+      if constexpr (is_published_v<RootStateT>) {
+        root.published_configuration.publish(leaf_id);
+      }
+    }
+  }
+  
+  // data kept only by the topmost state machine
+  template<typename ParentStateT>
+  struct Root_data {};
+  template<>
+  struct Root_data<uhsm::No_parent_state> {
+    // NOTE: updated on every state branch switch; not intended to be modified by the user
+    State_id private_active_leaf_id = 0;
+  };
+  
   // NOTE: the following are the definition of functors being invoked on a current state object (`StateT`)
   // held by a variant object (`StateDataT`) which consists of all possible states (`StateT`)
   // that a substate machine can be in at any given time
-
+  
+  // NOTE: event passing contract: a single event object is passed through the whole sequence
+  // of hooks invoked due to a transition and it is never copied; every hook observes the event
+  // via const-reference except for the last hook of the sequence (the event sink), which receives
+  // the event with the value category passed to `react()` and may take ownership of it:
+  // - for an internal transition it is the transition action,
+  // - for a state branch switch it is on_entry of the innermost entered (simple) state, unless
+  //   the destination state is constructed from the event (see `enter_dest_state`)
+  
+  // checks if on_entry/on_exit of a state accepts the context of the topmost state machine,
+  // i.e. it is callable as `on_entry(context, evt)`/`on_exit(context, evt)`
+  template<typename StateT, typename RootStateT, typename EventT, typename = void>
+  struct is_context_entry_hook : std::false_type {};
+  template<typename StateT, typename RootStateT, typename EventT>
+  struct is_context_entry_hook<StateT, RootStateT, EventT, std::void_t<decltype(
+    std::declval<StateT&>().on_entry(std::declval<RootStateT&>().context, std::declval<EventT>()))>> : std::true_type {};
+  template<typename StateT, typename RootStateT, typename EventT, typename = void>
+  struct is_context_exit_hook : std::false_type {};
+  template<typename StateT, typename RootStateT, typename EventT>
+  struct is_context_exit_hook<StateT, RootStateT, EventT, std::void_t<decltype(
+    std::declval<StateT&>().on_exit(std::declval<RootStateT&>().context, std::declval<EventT>()))>> : std::true_type {};
+  
+  // checks if on_entry/on_exit of a state is the default (empty) hook of `Simple_state`/`State_machine_def`
+  template<typename StateT, typename EventT, typename = void>
+  struct is_default_entry_hook : std::false_type {};
+  template<typename StateT, typename EventT>
+  struct is_default_entry_hook<StateT, EventT, std::enable_if_t<std::is_same_v<
+    decltype(std::declval<StateT&>().on_entry(std::declval<EventT>())), Default_hook>>> : std::true_type {};
+  template<typename StateT, typename EventT, typename = void>
+  struct is_default_exit_hook : std::false_type {};
+  template<typename StateT, typename EventT>
+  struct is_default_exit_hook<StateT, EventT, std::enable_if_t<std::is_same_v<
+    decltype(std::declval<StateT&>().on_exit(std::declval<EventT>())), Default_hook>>> : std::true_type {};
+  
+  // NOTE: default hooks are elided at compile time, i.e. neither invoked nor visited through
+  // the current states of nested levels; this holds within a profiled state machine as well,
+  // so no histogram of a state without a hook is ever recorded
+  
+  // checks if on_entry of a state is elided for an event (passed with a given value category)
+  template<typename StateT, typename RootStateT, typename EventT>
+  inline constexpr bool is_elided_entry_v =
+    !is_context_entry_hook<StateT, RootStateT, EventT>::value && is_default_entry_hook<StateT, EventT>::value;
+  // checks if on_exit of a state is elided for an event
+  template<typename StateT, typename RootStateT, typename EventT>
+  inline constexpr bool is_elided_exit_v =
+    !is_context_exit_hook<StateT, RootStateT, const EventT&>::value && is_default_exit_hook<StateT, const EventT&>::value;
+  
+  // checks if on_exit of all states of a list is elided for an event
+  template<typename StatesT, typename RootStateT, typename EventT>
+  struct are_exits_elided;
+  template<template<typename...> typename ListT, typename... StateTs, typename RootStateT, typename EventT>
+  struct are_exits_elided<ListT<StateTs...>, RootStateT, EventT>
+    : std::bool_constant<(is_elided_exit_v<StateTs, RootStateT, EventT> && ...)> {};
+  
+  // checks if exiting a state invokes no hook at all, i.e. on_exit of the state and of all (possibly current)
+  // states nested in it is elided for an event
+  template<typename StateT, typename RootStateT, typename EventT>
+  inline constexpr bool is_elided_exit_cascade_v = is_elided_exit_v<StateT, RootStateT, utils::remove_cvref_t<EventT>> &&
+    are_exits_elided<nested_states_t<StateT>, RootStateT, utils::remove_cvref_t<EventT>>::value;
+  
+  // checks if exiting the current state held by state data (a variant of states) invokes no hook at all
+  template<typename StateDataT, typename RootStateT, typename EventT>
+  struct is_elided_exit_cascade_of;
+  template<typename... StateTs, typename RootStateT, typename EventT>
+  struct is_elided_exit_cascade_of<std::variant<StateTs...>, RootStateT, EventT>
+    : std::bool_constant<(is_elided_exit_cascade_v<StateTs, RootStateT, EventT> && ...)> {};
+  
+  // starts measuring a hook invoked within a profiled state machine
+  template<typename RootStateT>
+  constexpr std::uint64_t profiling_start(RootStateT& root)
+  {
+    if constexpr (is_profiled_v<RootStateT>) {
+      return root.profiler.start();
+    } else {
+      return 0;
+    }
+  }
+  
+  // records the duration of a hook of a state invoked within a profiled state machine
+  template<Profiled_hook HookV, typename StateT, typename RootStateT>
+  constexpr void profiling_stop(RootStateT& root, std::uint64_t start)
+  {
+    if constexpr (is_profiled_v<RootStateT>) {
+      root.profiler.stop(HookV, state_id_v<RootStateT, StateT>, start);
+    }
+  }
+  
+  // records the duration of an action of a transition invoked within a profiled state machine
+  template<typename TransitionT, typename RootStateT>
+  constexpr void profiling_stop_action(RootStateT& root, std::uint64_t start)
+  {
+    if constexpr (is_profiled_v<RootStateT>) {
+      root.profiler.stop(Profiled_hook::action, transition_id_v<RootStateT, TransitionT>, start);
+    }
+  }
+  
+  template<typename StateT, typename EventT, typename RootStateT>
+  constexpr void invoke_entry_hook(StateT& state, EventT&& evt, RootStateT& root)
+  {
+    if constexpr (is_elided_entry_v<StateT, RootStateT, EventT&&>) {
+      return;
+    }
+    
+    const auto start = profiling_start(root);
+    
+    if constexpr (is_context_entry_hook<StateT, RootStateT, EventT&&>::value) {
+      state.on_entry(root.context, std::forward<EventT>(evt));
+    } else {
+      state.on_entry(std::forward<EventT>(evt));
+    }
+    
+    profiling_stop<Profiled_hook::entry, StateT>(root, start);
+  }
+  
+  // invokes on_entry on an entered state; only a simple state (the last one entered) is the event sink
+  template<typename StateT, typename EventT, typename RootStateT>
+  constexpr void invoke_on_entry(StateT& state, EventT&& evt, RootStateT& root)
+  {
+    if constexpr (is_composite_state_v<StateT>) {
+      invoke_entry_hook(state, std::as_const(evt), root);
+    } else {
+      invoke_entry_hook(state, std::forward<EventT>(evt), root);
+    }
+  }
+  
+  // invokes on_exit on an exited state; on_exit is never the event sink
+  template<typename StateT, typename EventT, typename RootStateT>
+  constexpr void invoke_on_exit(StateT& state, const EventT& evt, RootStateT& root)
+  {
+    if constexpr (is_elided_exit_v<StateT, RootStateT, EventT>) {
+      return;
+    }
+    
+    const auto start = profiling_start(root);
+    
+    if constexpr (is_context_exit_hook<StateT, RootStateT, const EventT&>::value) {
+      state.on_exit(root.context, evt);
+    } else {
+      state.on_exit(evt);
+    }
+    
+    profiling_stop<Profiled_hook::exit, StateT>(root, start);
+  }
+  
   struct On_entry_invocation {
-    template<typename StateT, typename EventT>
-    static void invoke(StateT& state, EventT&& evt)
+    template<typename StateT, typename EventT, typename RootStateT>
+    static constexpr void invoke(StateT& state, EventT&& evt, RootStateT& root)
     {
-      state.on_entry(std::forward<EventT>(evt));
+      invoke_on_entry(state, std::forward<EventT>(evt), root);
     }
   };
    
-  template<typename StateDataT, typename EventT>
-  constexpr void invoke_substate_entry(StateDataT& state_data, EventT&& evt)
+  template<typename StateDataT, typename EventT, typename RootStateT>
+  constexpr void invoke_substate_entry(StateDataT& state_data, EventT&& evt, RootStateT& root)
   {
     utils::variant_invocation<On_entry_invocation, StateDataT>::invoke(
-      state_data, std::forward<EventT>(evt));
+      state_data, std::forward<EventT>(evt), root);
   }
   
   struct On_exit_invocation {
     template<typename StateT, typename EventT>
-    static void invoke(StateT& state, EventT&& evt)
+    static constexpr void invoke(StateT& state, EventT&& evt)
     {
-      state.on_exit(std::forward<EventT>(evt));
+      state.on_exit(std::as_const(evt));
     }
   };
   
@@ -132,35 +583,89 @@ namespace uhsm::helpers
   }
   
   struct Recur_private_on_exit_invocation {
-    template<typename StateT, typename EventT>
-    static void invoke(StateT& state, EventT&& evt)
+    template<typename StateT, typename EventT, typename RootStateT>
+    static constexpr void invoke(StateT& state, EventT&& evt, RootStateT& root)
     {
-      state.private_invoke_on_exit(std::forward<EventT>(evt));
+      state.private_invoke_on_exit(std::forward<EventT>(evt), root);
     }
   };
   
-  template<typename StateDataT, typename EventT>
-  constexpr void invoke_private_exit_recur(StateDataT& state_data, EventT&& evt)
+  template<typename StateDataT, typename EventT, typename RootStateT>
+  constexpr void invoke_private_exit_recur(StateDataT& state_data, EventT&& evt, RootStateT& root)
   {
-    utils::variant_invocation<Recur_private_on_exit_invocation, StateDataT>::invoke(
-      state_data, std::forward<EventT>(evt));
+    // NOTE: the current nested states are not even visited if none of them has an on_exit hook
+    if constexpr (!is_elided_exit_cascade_of<StateDataT, RootStateT, EventT>::value) {
+      utils::variant_invocation<Recur_private_on_exit_invocation, StateDataT>::invoke(
+        state_data, std::forward<EventT>(evt), root);
+    }
   }
   
   struct Initialize_invocation {
-    template<typename StateT, typename EventT>
-    static void invoke(StateT& state, EventT&& evt)
+    template<typename StateT, typename EventT, typename RootStateT>
+    static constexpr void invoke(StateT& state, EventT&& evt, RootStateT& root)
     {
-      state.initialize(std::forward<EventT>(evt));
+      state.initialize(std::forward<EventT>(evt), root);
     }
   };
   
-  template<typename StateDataT, typename EventT>
-  constexpr void initialize_substate(StateDataT& state_data, EventT&& evt)
+  template<typename StateDataT, typename EventT, typename RootStateT>
+  constexpr void initialize_substate(StateDataT& state_data, EventT&& evt, RootStateT& root)
   {
     utils::variant_invocation<Initialize_invocation, StateDataT>::invoke(
-      state_data, std::forward<EventT>(evt));
+      state_data, std::forward<EventT>(evt), root);
   }
 
+  // checks if a destination state declares a constructor from an event triggering a transition to it
+  template<typename StateT, typename EventT>
+  inline constexpr bool is_event_constructible_v = std::is_constructible_v<StateT, EventT&&>;
+  
+  // enters the I-th alternative of a variant as the destination state of a transition
+  // NOTE: a destination state constructible from the event is constructed in place directly from it
+  // (with the value category passed to `react()`, so it may move the payload into its storage);
+  // it becomes the event sink, hooks invoked afterwards observe the (possibly moved-from) event
+  // via const-reference
+  template<size_t I, typename StateDataT, typename EventT, typename RootStateT>
+  constexpr auto& enter_dest_state(StateDataT& state_data, EventT&& evt, RootStateT& root)
+  {
+    using Dest_state = std::variant_alternative_t<I, StateDataT>;
+    
+    if constexpr (is_event_constructible_v<Dest_state, EventT>) {
+      auto& dest_state = state_data.template emplace<I>(std::forward<EventT>(evt));
+      invoke_on_entry(dest_state, std::as_const(evt), root);
+      dest_state.initialize(std::as_const(evt), root);
+      return dest_state;
+    } else {
+      auto& dest_state = state_data.template emplace<I>();
+      invoke_on_entry(dest_state, std::forward<EventT>(evt), root);
+      dest_state.initialize(std::forward<EventT>(evt), root);
+      return dest_state;
+    }
+  }
+  
+  // enters a destination state of a transition of a given state machine given by its index (known at runtime)
+  // NOTE: entering is only instantiated for states being destination states of transitions triggered
+  // by the event, so the other states need not be constructible from the event (nor default-constructible)
+  template<typename StateT, size_t I, typename EventT, typename RootStateT>
+  constexpr bool enter_dest_state_if_idx(StateT& state, size_t dest_idx, EventT&& evt, RootStateT& root)
+  {
+    using Dest_state = std::tuple_element_t<I, typename StateT::template State_set<StateT>>;
+    
+    if constexpr (has_tr_to_dest_state_v<Dest_state, utils::remove_cvref_t<EventT>, typename StateT::Transitions>) {
+      if (dest_idx == I) {
+        enter_dest_state<I>(state.state_data, std::forward<EventT>(evt), root);
+        return true;
+      }
+    }
+    return false;
+  }
+  template<typename StateT, typename EventT, typename RootStateT, size_t... Is>
+  constexpr void enter_dest_state_by_idx(StateT& state, size_t dest_idx, EventT&& evt, RootStateT& root,
+    std::index_sequence<Is...>)
+  {
+    // NOTE: only the matching alternative is entered (the fold short-circuits)
+    (void)(enter_dest_state_if_idx<StateT, Is>(state, dest_idx, std::forward<EventT>(evt), root) || ...);
+  }
+  
   // indicates that no matching transition table entry was found and the index of the next state
   // cannot be determined  
   constexpr auto invalid_state_idx_ = std::numeric_limits<size_t>::max();
@@ -197,42 +702,86 @@ namespace uhsm::helpers
     }
   };
   
-  // a functor that invokes an action bound by the template paramter
-  template<typename ActionT>
+  // checks if the topmost state machine defines a `context` data member which is accessible
+  // to transition actions
+  template<typename RootStateT, typename = void>
+  struct has_context : std::false_type {};
+  template<typename RootStateT>
+  struct has_context<RootStateT, std::void_t<decltype(std::declval<RootStateT&>().context)>> : std::true_type {};
+  // helper variable template for `has_context`
+  template<typename RootStateT>
+  inline constexpr bool has_context_v = has_context<RootStateT>::value;
+  
+  // checks if an action accepts the context of the topmost state machine, i.e. it is callable as
+  // `action(context, src_state, evt)` with mutable access to both the context and the source state
+  template<typename ActionT, typename RootStateT, typename SrcStateT, typename EventT, typename = void>
+  struct is_context_action : std::false_type {};
+  template<typename ActionT, typename RootStateT, typename SrcStateT, typename EventT>
+  struct is_context_action<ActionT, RootStateT, SrcStateT, EventT, std::enable_if_t<has_context_v<RootStateT>>>
+    : std::is_invocable<ActionT&, decltype(std::declval<RootStateT&>().context)&, SrcStateT&, EventT> {};
+  // helper variable template for `is_context_action`
+  template<typename ActionT, typename RootStateT, typename SrcStateT, typename EventT>
+  inline constexpr bool is_context_action_v = is_context_action<ActionT, RootStateT, SrcStateT, EventT>::value;
+  
+  // a functor that invokes an action of a transition bound by the template paramter
+  // NOTE: actions are stateless (empty) function objects, so constructing one is free;
+  // any data an action operates on belongs to the context of the topmost state machine
+  template<typename TransitionT>
   struct Action_invocation {
-    template<typename SrcStateT, typename EventT>
-    static void invoke(const SrcStateT& src_state, EventT&& evt)
+    using Action = get_tr_action<TransitionT>;
+    static_assert(std::is_empty_v<Action>, "An action must be stateless (an empty function object); "
+      "keep its data in the context of the topmost state machine");
+    
+    template<typename SrcStateT, typename EventT, typename RootStateT>
+    static constexpr void invoke(SrcStateT& src_state, EventT&& evt, RootStateT& root)
     {
-      ActionT action;
-      action(src_state, std::forward<EventT>(evt));
+      Action action;
+      // NOTE: actions are measured per transition; empty actions are not measured
+      const auto start = std::is_same_v<Action, Empty_action> ? 0 : profiling_start(root);
+      
+      if constexpr (is_context_action_v<Action, RootStateT, SrcStateT, EventT>) {
+        action(root.context, src_state, std::forward<EventT>(evt));
+      } else {
+        action(std::as_const(src_state), std::forward<EventT>(evt));
+      }
+      
+      if constexpr (!std::is_same_v<Action, Empty_action>) {
+        profiling_stop_action<TransitionT>(root, start);
+      }
     }
   };
-  // invokes an action on a current state object held by the variant
-  template<typename ActionT, typename StateDataT, typename EventT>
-  constexpr void invoke_action(const StateDataT& state_data, EventT&& evt)
+  // invokes an action of a transition on a current state object held by the variant
+  template<typename TransitionT, typename StateDataT, typename EventT, typename RootStateT>
+  constexpr void invoke_action(StateDataT& state_data, EventT&& evt, RootStateT& root)
   {
-    utils::variant_invocation<Action_invocation<ActionT>, StateDataT>::invoke(
-      state_data, std::forward<EventT>(evt));
+    utils::variant_invocation<Action_invocation<TransitionT>, StateDataT>::invoke(
+      state_data, std::forward<EventT>(evt), root);
   }
   
   // traverses the transition table looking for an entry describing a transition source state `StateT`
   // due to `EventT` event; performs a transition action and return an indexed of the next state
   // or indicates that this event cannot be handled at this hierarchy level
-  template<typename StateT, typename EventT, typename TransitionT, typename... TransitionTs>
-  constexpr auto get_next_state_perform_action_impl(const StateT& state, EventT&& evt)
+  template<typename StateT, typename EventT, typename RootStateT, typename TransitionT, typename... TransitionTs>
+  constexpr auto get_next_state_perform_action_impl(StateT& state, EventT&& evt, RootStateT& root)
   {
     using Nested_state_set = typename StateT::template State_set<StateT>;
     
-    if (get_tr_src_state_idx_v<Nested_state_set, TransitionT> == state.state_data.index() &&
-      std::is_same_v<get_tr_event<TransitionT>, EventT>) {        
-      invoke_action<get_tr_action<TransitionT>>(state.state_data, std::forward<EventT>(evt));
-               
-      return get_tr_dest_state_idx_v<Nested_state_set, TransitionT>;
+    if constexpr (std::is_same_v<get_tr_event<TransitionT>, utils::remove_cvref_t<EventT>>) {
+      if (get_tr_src_state_idx_v<Nested_state_set, TransitionT> == state.state_data.index()) {
+        if constexpr (std::is_same_v<get_tr_src_state<TransitionT>, get_tr_dest_state<TransitionT>>) {
+          // NOTE: an action of an internal transition is the only hook invoked, hence the event sink
+          invoke_action<TransitionT>(state.state_data, std::forward<EventT>(evt), root);
+        } else {
+          invoke_action<TransitionT>(state.state_data, std::as_const(evt), root);
+        }
+        
+        return get_tr_dest_state_idx_v<Nested_state_set, TransitionT>;
+      }
     }
     
     if constexpr (sizeof...(TransitionTs) > 0) {
-      return get_next_state_perform_action_impl<StateT, EventT, TransitionTs...>(
-        state, std::forward<EventT>(evt));
+      return get_next_state_perform_action_impl<StateT, EventT, RootStateT, TransitionTs...>(
+        state, std::forward<EventT>(evt), root);
     } else {
       return invalid_state_idx_;
     }
@@ -243,40 +792,35 @@ namespace uhsm::helpers
   template<typename StateT, typename EventT, typename HeadTrT, typename... TailTrTs>
   struct Next_state_helper<StateT, EventT, uhsm::Transition_table<HeadTrT, TailTrTs...>> {
     static constexpr auto invalid_state_idx = helpers::invalid_state_idx_;
-    static constexpr auto get_next_state_perform_action(const StateT& state, EventT&& evt)
+    template<typename RootStateT>
+    static constexpr auto get_next_state_perform_action(StateT& state, EventT&& evt, RootStateT& root)
     {
-      return get_next_state_perform_action_impl<StateT, EventT, HeadTrT, TailTrTs...>(
-        state, std::forward<EventT>(evt));
+      return get_next_state_perform_action_impl<StateT, EventT, RootStateT, HeadTrT, TailTrTs...>(
+        state, std::forward<EventT>(evt), root);
     }
   };
   
-  // a function implementing a base algorithm of a hierarchical state machine
-  template<typename StateT, typename EventT, typename NestedStateT, typename... NestedStateTs>
-  constexpr auto dispatch_event_impl(StateT& state, EventT&& evt) {
+  // handles an event at a given hierarchy level (once it could not be handled by a more nested level)
+  // by looking up the transition table of this level and switching a state branch if required
+  template<typename StateT, typename EventT, typename RootStateT>
+  constexpr bool handle_at_level(StateT& state, EventT&& evt, RootStateT& root)
+  {
     using Nested_state_set = typename StateT::template State_set<StateT>;
-      
-    if (constexpr auto state_idx = get_state_idx_v<NestedStateT, Nested_state_set>;
-      state_idx == state.state_data.index()) {
-      // current state for this state hierarchy level found; dispatch the event to it by calling `react()`
-      auto& current_nested_state = std::get<state_idx>(state.state_data);
-          
-      if (current_nested_state.react(std::forward<EventT>(evt))) {
-        // the event was handled; end of processing
-        return true;
-      }
-          
-      // NOTE: the event could not be handled at more nested hierarchy level;
-      // try to handle it at this level
-          
+    
+    if constexpr (!has_tr_w_event_v<utils::remove_cvref_t<EventT>, typename StateT::Transitions>) {
+      // NOTE: no transition at this level is triggered by this event type; defer processing
+      // of the event to a higher hierarchy level without instantiating the lookup
+      return false;
+    } else {
       const auto next_state_idx = Next_state_helper<StateT, EventT, typename StateT::Transitions>
-        ::get_next_state_perform_action(state, std::forward<EventT>(evt));
-          
+        ::get_next_state_perform_action(state, std::forward<EventT>(evt), root);
+      
       if (next_state_idx == state.state_data.index()) {
         // this is an internal transition (source state and destination state are the same);
         // do not change the state data in any way; do not call on_entry/on_exit
         return true;
       }
-        
+      
       if (next_state_idx == invalid_state_idx_) {
         // the event cannot be handled at this level (no matching entry in the transition table);
         // defer processing of the event to a higher hierarchy level
@@ -284,24 +828,47 @@ namespace uhsm::helpers
       }
       
       // NOTE: at this point it is known that at this level a state branch switch occurs
-        
+      
       // recursively call on_exit on all current nested states (in LIFO order)
       // before switching to a new state branch
-      invoke_private_exit_recur(state.state_data, std::forward<EventT>(evt));
-      // set current state for this hierarchy level and invoke on_entry on it
-      state.state_data = utils::Variant_by_index<Nested_state_set>::make(next_state_idx);
-      invoke_substate_entry(state.state_data, std::forward<EventT>(evt));    
-      // recursively set initial state for the new current substate (invokes on_entry on nested states)
-      // NOTE: once current state object is assigned to the variant object for this hierarchy level
-      // the nested variant objects are set to their first alternative; initial states for nestes levels
-      // must be set explicitly
-      initialize_substate(state.state_data, std::forward<EventT>(evt));
-        
+      invoke_private_exit_recur(state.state_data, std::as_const(evt), root);
+      // set current state for this hierarchy level, invoke on_entry on it and recursively set initial
+      // states of its nested levels (invokes on_entry on nested states)
+      enter_dest_state_by_idx(state, next_state_idx, std::forward<EventT>(evt), root,
+        std::make_index_sequence<std::tuple_size_v<Nested_state_set>>{});
+      update_active_leaf(root, Initial_leaf_ids<RootStateT, Nested_state_set>::table[next_state_idx]);
+      
       return true;
     }
+  }
+  
+  // a function implementing a base algorithm of a hierarchical state machine
+  // NOTE: the topmost state machine (`root`) is passed down through all hierarchy levels
+  template<typename StateT, typename EventT, typename RootStateT, typename NestedStateT, typename... NestedStateTs>
+  constexpr auto dispatch_event_impl(StateT& state, EventT&& evt, RootStateT& root) {
+    using Nested_state_set = typename StateT::template State_set<StateT>;
+      
+    if (constexpr auto state_idx = get_state_idx_v<NestedStateT, Nested_state_set>;
+      state_idx == state.state_data.index()) {
+      // current state for this state hierarchy level found; dispatch the event to it
+      // NOTE: nested states whose hierarchy cannot handle the event are skipped at compile time
+      if constexpr (handles_event_v<NestedStateT, EventT>) {
+        auto& current_nested_state = std::get<state_idx>(state.state_data);
+        
+        if (current_nested_state.private_react(std::forward<EventT>(evt), root)) {
+          // the event was handled; end of processing
+          return true;
+        }
+      }
+          
+      // NOTE: the event could not be handled at more nested hierarchy level;
+      // try to handle it at this level
+      return handle_at_level(state, std::forward<EventT>(evt), root);
+    }
       
     if constexpr (sizeof...(NestedStateTs) > 0) {
-      return dispatch_event_impl<StateT, EventT, NestedStateTs...>(state, std::forward<EventT>(evt));
+      return dispatch_event_impl<StateT, EventT, RootStateT, NestedStateTs...>(
+        state, std::forward<EventT>(evt), root);
     } else {   
       // WARNING: cannot reach here; every state hierarchy level must have a current state at any given time
       // TODO: implement exception handling
@@ -313,9 +880,10 @@ namespace uhsm::helpers
   struct Event_dispatcher;
   template<typename StateT, typename EventT, typename NestedStateT, typename... NestedStateTs>
   struct Event_dispatcher<StateT, EventT, std::tuple<NestedStateT, NestedStateTs...>> {
-    static constexpr auto dispatch(StateT& state, EventT && event) {
-      return dispatch_event_impl<StateT, EventT, NestedStateT, NestedStateTs...>(
-        state, std::forward<EventT>(event));
+    template<typename RootStateT>
+    static constexpr auto dispatch(StateT& state, EventT && event, RootStateT& root) {
+      return dispatch_event_impl<StateT, EventT, RootStateT, NestedStateT, NestedStateTs...>(
+        state, std::forward<EventT>(event), root);
     }
   };
     
@@ -456,6 +1024,12 @@ namespace uhsm::helpers
     static_assert(std::is_same_v<State_data_def, std::variant<StateA, StateB, StateC>>);
   }
   
+  namespace Test::ExtractEventSet_TransitionTablePassed_ReturnUniqueEvents
+  {
+    using Event_set = extract_event_set_t<Test_data::Transitions>;
+    static_assert(std::is_same_v<Event_set, std::tuple<Test_data::Pwr_btn_pressed, Test_data::Brownout>>);
+  }
+  
   namespace Test::HasTrWithSrcEvt_TransitionTablePassed_DetectDuplicates
   {
     struct StateA {};
@@ -473,6 +1047,17 @@ namespace uhsm::helpers
     
     static_assert(utils::has_duplicates_v<has_tr_w_src_evt, Transitions>);
   }
+  
+  namespace Test::FindTrIdx_TransitionTablePassed_ReturnFirstMatchingIdx
+  {
+    using Test_data::Off;
+    using Test_data::On;
+    using Test_data::Pwr_btn_pressed;
+    using Test_data::Brownout;
+  
+    static_assert(find_tr_idx<On, Brownout>(static_cast<Test_data::Transitions*>(nullptr)) == 2);
+    static_assert(find_tr_idx<Off, Brownout>(static_cast<Test_data::Transitions*>(nullptr)) == 3);
+  }
 }
 
 #endif
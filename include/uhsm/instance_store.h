@@ -0,0 +1,244 @@
+#ifndef UHSM_INSTANCE_STORE_H_
+#define UHSM_INSTANCE_STORE_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "uhsm/utils.h"
+
+// NOTE: a container of state machine instances keyed by a 64-bit ID (e.g. a session ID); it is
+// an open-addressing hash table with linear probing which keeps IDs and instances inline in two
+// parallel arrays, so a lookup touches at most a few adjacent cache lines and no memory is
+// allocated per instance; the arrays are allocated once at construction and never grow
+// NOTE: erasing shifts following entries of the probe sequence back (instead of leaving
+// tombstones), so probe sequences stay short under any insert/erase pattern; thus instances
+// may be moved within the store on erase and pointers to them are invalidated
+
+namespace uhsm
+{
+  template<typename StateMachineT>
+  class Instance_store {
+  public:
+    static_assert(std::is_nothrow_move_constructible_v<StateMachineT>, "State machine must be nothrow move constructible");
+
+    // NOTE: the ID reserved for marking empty slots; it can never be stored
+    static constexpr std::uint64_t invalid_id = ~std::uint64_t{0};
+    // number of lookups of a batch whose slots are prefetched at once
+    static constexpr std::size_t batch_size = 16;
+
+    // creates a store for a given maximal number of instances
+    explicit Instance_store(std::size_t capacity) :
+      mask_{slot_count_for(capacity) - 1},
+      capacity_{capacity},
+      ids_{new std::uint64_t[mask_ + 1]},
+      instances_{new Instance_storage[mask_ + 1]}
+    {
+      std::fill_n(ids_.get(), mask_ + 1, invalid_id);
+    }
+
+    Instance_store(const Instance_store&) = delete;
+    Instance_store& operator=(const Instance_store&) = delete;
+
+    ~Instance_store()
+    {
+      clear();
+    }
+
+    // constructs and starts an instance with a given ID; gives nullptr if the ID is already
+    // present or the store is full
+    template<typename... ArgTs>
+    StateMachineT* emplace(std::uint64_t id, ArgTs&&... args)
+    {
+      assert(id != invalid_id);
+
+      if (size_ == capacity_) {
+        return nullptr;
+      }
+
+      std::size_t idx = home_slot(id);
+      for (; ids_[idx] != invalid_id; idx = (idx + 1) & mask_) {
+        if (ids_[idx] == id) {
+          return nullptr;
+        }
+      }
+
+      auto* sm = ::new (static_cast<void*>(&instances_[idx])) StateMachineT{std::forward<ArgTs>(args)...};
+      ids_[idx] = id;
+      ++size_;
+      sm->start();
+      return sm;
+    }
+
+    // gives an instance with a given ID (or nullptr if there is none)
+    StateMachineT* find(std::uint64_t id)
+    {
+      return find_from(id, home_slot(id));
+    }
+
+    // looks up instances for a burst of IDs; slots of each batch are prefetched before they are probed,
+    // so cache misses of lookups within a batch overlap
+    void find_batch(const std::uint64_t* ids, std::size_t count, StateMachineT** found)
+    {
+      std::size_t homes[batch_size];
+
+      for (std::size_t base = 0; base < count; base += batch_size) {
+        const std::size_t batch_count = std::min(batch_size, count - base);
+
+        for (std::size_t i = 0; i < batch_count; ++i) {
+          homes[i] = home_slot(ids[base + i]);
+          utils::prefetch(&ids_[homes[i]]);
+          utils::prefetch(&instances_[homes[i]]);
+        }
+        for (std::size_t i = 0; i < batch_count; ++i) {
+          found[base + i] = find_from(ids[base + i], homes[i]);
+        }
+      }
+    }
+
+    // passes an event to an instance with a given ID; returns false if there is no such instance
+    // or the event has not been handled
+    template<typename EventT>
+    bool react(std::uint64_t id, EventT&& evt)
+    {
+      auto* sm = find(id);
+      return sm != nullptr && sm->react(std::forward<EventT>(evt));
+    }
+
+    // destroys an instance with a given ID; returns false if there is none
+    bool erase(std::uint64_t id)
+    {
+      std::size_t idx = home_slot(id);
+      for (; ids_[idx] != id; idx = (idx + 1) & mask_) {
+        if (ids_[idx] == invalid_id) {
+          return false;
+        }
+      }
+
+      instance_at(idx).~StateMachineT();
+      --size_;
+
+      // moves back each following entry of the cluster which may not be placed before its home slot
+      std::size_t hole = idx;
+      for (std::size_t next = (hole + 1) & mask_; ids_[next] != invalid_id; next = (next + 1) & mask_) {
+        const std::size_t home = home_slot(ids_[next]);
+        if (((next - home) & mask_) >= ((next - hole) & mask_)) {
+          ::new (static_cast<void*>(&instances_[hole])) StateMachineT{std::move(instance_at(next))};
+          instance_at(next).~StateMachineT();
+          ids_[hole] = ids_[next];
+          hole = next;
+        }
+      }
+
+      ids_[hole] = invalid_id;
+      return true;
+    }
+
+    // constructs and starts instances with given IDs; gives the number of inserted instances
+    std::size_t insert_bulk(const std::uint64_t* ids, std::size_t count)
+    {
+      std::size_t inserted = 0;
+      for (std::size_t i = 0; i < count; ++i) {
+        inserted += emplace(ids[i]) != nullptr;
+      }
+      return inserted;
+    }
+
+    // destroys instances with given IDs; gives the number of erased instances
+    std::size_t erase_bulk(const std::uint64_t* ids, std::size_t count)
+    {
+      std::size_t erased = 0;
+      for (std::size_t i = 0; i < count; ++i) {
+        erased += erase(ids[i]);
+      }
+      return erased;
+    }
+
+    void clear()
+    {
+      for (std::size_t idx = 0; size_ != 0; ++idx) {
+        if (ids_[idx] != invalid_id) {
+          instance_at(idx).~StateMachineT();
+          ids_[idx] = invalid_id;
+          --size_;
+        }
+      }
+    }
+
+    std::size_t size() const
+    {
+      return size_;
+    }
+
+    std::size_t capacity() const
+    {
+      return capacity_;
+    }
+
+    bool empty() const
+    {
+      return size_ == 0;
+    }
+
+    // gives the number of slots for a given capacity, so that the load factor does not exceed 7/8
+    static constexpr std::size_t slot_count_for(std::size_t capacity)
+    {
+      std::size_t slot_count = 16;
+      while (slot_count / 8 * 7 < capacity) {
+        slot_count *= 2;
+      }
+      return slot_count;
+    }
+
+  private:
+    struct Instance_storage {
+      alignas(StateMachineT) std::byte bytes[sizeof(StateMachineT)];
+    };
+
+    // Fibonacci hashing; the highest bits of the product are the best mixed ones
+    std::size_t home_slot(std::uint64_t id) const
+    {
+      return static_cast<std::size_t>((id * 0x9E3779B97F4A7C15ull) >> (64 - utils::highest_bit_idx(mask_ + 1)));
+    }
+
+    StateMachineT* find_from(std::uint64_t id, std::size_t idx)
+    {
+      for (; ids_[idx] != invalid_id; idx = (idx + 1) & mask_) {
+        if (ids_[idx] == id) {
+          return &instance_at(idx);
+        }
+      }
+      return nullptr;
+    }
+
+    StateMachineT& instance_at(std::size_t idx)
+    {
+      return *std::launder(reinterpret_cast<StateMachineT*>(&instances_[idx]));
+    }
+
+    std::size_t mask_;
+    std::size_t capacity_;
+    std::size_t size_ = 0;
+    std::unique_ptr<std::uint64_t[]> ids_;
+    std::unique_ptr<Instance_storage[]> instances_;
+  };
+
+  // Compile-time tests
+  ////////////////////////////////////////////////////////////////////////////////
+
+  namespace Test::InstanceStoreSlotCount_CapacityPassed_ReturnPowerOfTwoBelowMaxLoad
+  {
+    struct Sm {};
+
+    static_assert(Instance_store<Sm>::slot_count_for(0) == 16);
+    static_assert(Instance_store<Sm>::slot_count_for(14) == 16);
+    static_assert(Instance_store<Sm>::slot_count_for(15) == 32);
+    static_assert(Instance_store<Sm>::slot_count_for(10'000'000) == (std::size_t{1} << 24));
+  }
+}
+
+#endif
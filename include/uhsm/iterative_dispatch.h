@@ -0,0 +1,375 @@
+#ifndef UHSM_ITERATIVE_DISPATCH_H_
+#define UHSM_ITERATIVE_DISPATCH_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include "uhsm/helpers.h"
+#include "uhsm/cross_transition.h"
+
+// NOTE: an alternative implementation of the base algorithm of a hierarchical state machine
+// with a stack depth independent of the nesting depth; the active path is walked in a loop
+// (from the current innermost state up to the topmost state machine) over constant tables indexed
+// by global state identifiers: the parent of each state, its initial nested state and, per event type,
+// a transition step of each state being a source state of a transition triggered by the event;
+// exited states (innermost first) and entered initial states (outermost first) are walked by loops
+// over the same tables, so no call made by the library recurses once per hierarchy level
+
+namespace uhsm::helpers
+{
+  // indicates the absence of a state (a parent of a state of the topmost state machine,
+  // an initial state of a simple state)
+  inline constexpr State_id no_state_id = std::numeric_limits<State_id>::max();
+
+  // gives the depth of a state within the hierarchy (1 for states of the topmost state machine)
+  template<typename RootStateT, typename StateT>
+  inline constexpr std::size_t state_depth_v = std::tuple_size_v<state_path_t<RootStateT, StateT>>;
+
+  // gives the maximum depth of a state within the hierarchy of the topmost state machine
+  template<typename RootStateT, typename StatesT = nested_states_t<RootStateT>>
+  struct max_nesting_depth;
+  template<typename RootStateT, typename... StateTs>
+  struct max_nesting_depth<RootStateT, std::tuple<StateTs...>> {
+    static constexpr std::size_t value = std::max({std::size_t{0}, state_depth_v<RootStateT, StateTs>...});
+  };
+  // helper variable template for `max_nesting_depth`
+  template<typename RootStateT>
+  inline constexpr std::size_t max_nesting_depth_v = max_nesting_depth<RootStateT>::value;
+
+  // NOTE: the number of nested calls of the library's own functions made from `react()` of the topmost
+  // state machine in the iterative dispatch mode along its longest chain, i.e. when a transition enters
+  // initial states of its dest. state: react, private_dispatch, Iterative_dispatcher::dispatch, the transition
+  // step (Iterative_transition::execute or Iterative_cross_transition::try_execute), Iterative_steps::enter_dest,
+  // enter_initials, enter_initial, invoke_on_entry and invoke_entry_hook; hooks, actions, the profiler
+  // and the standard library are excluded
+  inline constexpr std::size_t iterative_event_call_depth = 9;
+  // NOTE: the number of calls added to the chain when a variant of events is passed to `react()`: the step
+  // of the held alternative (Variant_dispatcher::dispatch_fused takes the place of Iterative_dispatcher::dispatch)
+  inline constexpr std::size_t iterative_variant_call_depth = 1;
+  // upper bound of the number of nested calls of the library's own functions made from `react()`
+  // in the iterative dispatch mode; it does not depend on the hierarchy depth
+  inline constexpr std::size_t iterative_dispatch_call_depth = iterative_event_call_depth + iterative_variant_call_depth;
+
+  // gives an upper bound of the stack used by the library while dispatching an event in the iterative
+  // dispatch mode given the largest frame of its functions (e.g. as reported by GCC's `-fstack-usage`
+  // for the build at hand); stack used by hooks and actions is to be added
+  constexpr std::size_t iterative_dispatch_stack_bound(std::size_t max_frame_bytes)
+  {
+    return iterative_dispatch_call_depth * max_frame_bytes;
+  }
+
+  // checks if a state is the initial state of its parent state machine
+  template<typename RootStateT, typename StateT>
+  constexpr bool is_initial_state()
+  {
+    using Path = state_path_t<RootStateT, StateT>;
+    constexpr std::size_t depth = std::tuple_size_v<Path>;
+
+    if constexpr (depth == 1) {
+      return std::is_same_v<typename RootStateT::Initial, StateT>;
+    } else {
+      return std::is_same_v<typename std::tuple_element_t<depth - 2, Path>::Initial, StateT>;
+    }
+  }
+
+  // tables of the static structure of the hierarchy indexed by global state identifiers
+  template<typename RootStateT>
+  struct Hierarchy_links {
+    using States = nested_states_t<RootStateT>;
+
+    template<typename StateT>
+    static constexpr State_id parent_id()
+    {
+      using Path = state_path_t<RootStateT, StateT>;
+      constexpr std::size_t depth = std::tuple_size_v<Path>;
+
+      if constexpr (depth == 1) {
+        return no_state_id;
+      } else {
+        return state_id_v<RootStateT, std::tuple_element_t<depth - 2, Path>>;
+      }
+    }
+
+    template<typename StateT>
+    static constexpr State_id initial_id()
+    {
+      if constexpr (is_composite_state_v<StateT>) {
+        return state_id_v<RootStateT, typename StateT::Initial>;
+      } else {
+        return no_state_id;
+      }
+    }
+
+    template<std::size_t... Is>
+    static constexpr auto make_parents(std::index_sequence<Is...>)
+    {
+      return std::array<State_id, sizeof...(Is)>{{parent_id<std::tuple_element_t<Is, States>>()...}};
+    }
+
+    template<std::size_t... Is>
+    static constexpr auto make_initials(std::index_sequence<Is...>)
+    {
+      return std::array<State_id, sizeof...(Is)>{{initial_id<std::tuple_element_t<Is, States>>()...}};
+    }
+
+    static constexpr auto parents = make_parents(std::make_index_sequence<state_count_v<RootStateT>>{});
+    static constexpr auto initials = make_initials(std::make_index_sequence<state_count_v<RootStateT>>{});
+  };
+
+  // steps exiting and entering single states for an event type (passed with a given value category)
+  template<typename RootStateT, typename EventT>
+  struct Iterative_steps {
+    using Event = utils::remove_cvref_t<EventT>;
+    using States = nested_states_t<RootStateT>;
+    using Exit_fn = void (*)(RootStateT&, const Event&);
+    using Entry_fn = void (*)(RootStateT&, EventT&&);
+
+    template<typename StateT>
+    static void exit(RootStateT& root, const Event& evt)
+    {
+      using Path = state_path_t<RootStateT, StateT>;
+      invoke_on_exit(get_on_path<Path, std::tuple_size_v<Path>>(root), evt, root);
+    }
+
+    // enters an initial state of a state machine which has just been entered
+    template<typename StateT>
+    static void enter_initial(RootStateT& root, EventT&& evt)
+    {
+      using Path = state_path_t<RootStateT, StateT>;
+
+      auto& state = get_on_path<Path, std::tuple_size_v<Path> - 1>(root).state_data.template emplace<StateT>();
+      invoke_on_entry(state, std::forward<EventT>(evt), root);
+    }
+
+    template<std::size_t... Is>
+    static constexpr auto make_exits(std::index_sequence<Is...>)
+    {
+      return std::array<Exit_fn, sizeof...(Is)>{{&exit<std::tuple_element_t<Is, States>>...}};
+    }
+
+    // NOTE: entering is only instantiated for initial states, so the other states need not be
+    // default-constructible
+    template<typename StateT>
+    static constexpr Entry_fn get_entry()
+    {
+      if constexpr (is_initial_state<RootStateT, StateT>()) {
+        return &enter_initial<StateT>;
+      } else {
+        return nullptr;
+      }
+    }
+
+    template<std::size_t... Is>
+    static constexpr auto make_entries(std::index_sequence<Is...>)
+    {
+      return std::array<Entry_fn, sizeof...(Is)>{{get_entry<std::tuple_element_t<Is, States>>()...}};
+    }
+
+    static constexpr auto exits = make_exits(std::make_index_sequence<state_count_v<RootStateT>>{});
+    static constexpr auto entries = make_entries(std::make_index_sequence<state_count_v<RootStateT>>{});
+
+    // exits states from the current innermost state up to a given state (included)
+    static void exit_up_to(RootStateT& root, const Event& evt, State_id last_id)
+    {
+      for (State_id id = root.private_active_leaf_id;; id = Hierarchy_links<RootStateT>::parents[id]) {
+        exits[id](root, evt);
+        if (id == last_id) {
+          break;
+        }
+      }
+    }
+
+    // enters a dest. state of a transition (as `enter_dest_state` would, except that initial states
+    // are entered by a loop instead of recursive `initialize`)
+    template<typename DestStateT>
+    static void enter_dest(RootStateT& root, EventT&& evt)
+    {
+      using Path = state_path_t<RootStateT, DestStateT>;
+      constexpr auto dest_id = state_id_v<RootStateT, DestStateT>;
+
+      auto& level = get_on_path<Path, std::tuple_size_v<Path> - 1>(root);
+      constexpr auto dest_idx = get_state_idx_v<DestStateT, state_set_t<utils::remove_cvref_t<decltype(level)>>>;
+
+      if constexpr (is_event_constructible_v<DestStateT, EventT>) {
+        auto& dest_state = level.state_data.template emplace<dest_idx>(std::forward<EventT>(evt));
+        invoke_on_entry(dest_state, std::as_const(evt), root);
+        Iterative_steps<RootStateT, const Event&>::enter_initials(root, std::as_const(evt), dest_id);
+      } else {
+        auto& dest_state = level.state_data.template emplace<dest_idx>();
+        invoke_on_entry(dest_state, std::forward<EventT>(evt), root);
+        enter_initials(root, std::forward<EventT>(evt), dest_id);
+      }
+    }
+
+    // enters initial states of nested state machines of an entered state
+    // NOTE: the event is forwarded to each step, but only a simple state (the last one entered) is the event sink
+    static void enter_initials(RootStateT& root, EventT&& evt, State_id entered_id)
+    {
+      for (State_id id = Hierarchy_links<RootStateT>::initials[entered_id]; id != no_state_id;
+        id = Hierarchy_links<RootStateT>::initials[id]) {
+        entries[id](root, std::forward<EventT>(evt));
+      }
+    }
+  };
+
+  // executes a transition triggered by an event whose source state is a given state
+  template<typename RootStateT, typename EventT, typename SrcStateT>
+  struct Iterative_transition {
+    using Event = utils::remove_cvref_t<EventT>;
+    using Path = state_path_t<RootStateT, SrcStateT>;
+    static constexpr std::size_t depth = std::tuple_size_v<Path>;
+    using Level = std::tuple_element_t<depth - 1, utils::prepend_t<RootStateT, Path>>;
+    using Transitions = typename Level::Transitions;
+
+    static constexpr std::size_t tr_idx = find_tr_idx<SrcStateT, Event>(static_cast<Transitions*>(nullptr));
+    static constexpr bool exists = tr_idx < std::tuple_size_v<Transitions>;
+
+    static bool execute(RootStateT& root, EventT&& evt)
+    {
+      static_assert(!has_ambiguous_trs_v<Transitions>, "Transition table may not have ambiguous transitions");
+
+      using Transition = std::tuple_element_t<tr_idx, Transitions>;
+      using Dest_state = get_tr_dest_state<Transition>;
+
+      auto& level = get_on_path<Path, depth - 1>(root);
+      auto& src_state = *std::get_if<SrcStateT>(&level.state_data);
+
+      if constexpr (std::is_same_v<SrcStateT, Dest_state>) {
+        // internal transition; do not call on_entry/on_exit
+        Action_invocation<Transition>::invoke(src_state, std::forward<EventT>(evt), root);
+      } else {
+        Action_invocation<Transition>::invoke(src_state, std::as_const(evt), root);
+        if constexpr (!is_elided_exit_cascade_v<SrcStateT, RootStateT, Event>) {
+          Iterative_steps<RootStateT, EventT>::exit_up_to(root, evt, state_id_v<RootStateT, SrcStateT>);
+        }
+
+        Iterative_steps<RootStateT, EventT>::template enter_dest<Dest_state>(root, std::forward<EventT>(evt));
+        update_active_leaf(root, initial_leaf_id_v<RootStateT, Dest_state>);
+      }
+
+      return true;
+    }
+  };
+
+  // executes a cross-level transition if its source state is current; exited states are walked
+  // by the same loop as for a regular transition and states on the path from the LCA down to the dest.
+  // state are entered by a fold expression, so neither recurses once per hierarchy level
+  template<typename RootStateT, typename EventT, typename TransitionT>
+  struct Iterative_cross_transition {
+    using Event = utils::remove_cvref_t<EventT>;
+    using Src_state = get_tr_src_state<TransitionT>;
+    using Dest_state = get_tr_dest_state<TransitionT>;
+    using Src_path = typename Cross_transition<RootStateT, TransitionT>::Src_path;
+    using Dest_path = typename Cross_transition<RootStateT, TransitionT>::Dest_path;
+    static constexpr std::size_t lca_depth = Cross_transition<RootStateT, TransitionT>::lca_depth;
+    // the state of the LCA's state machine exited by the transition
+    using Exited_state = std::tuple_element_t<lca_depth, Src_path>;
+
+    // enters a state on the path to the dest. state (at a given depth of the path)
+    template<std::size_t I>
+    static void enter_on_path(RootStateT& root, const Event& evt)
+    {
+      auto& entered_state = get_on_path<Dest_path, I>(root).state_data.template emplace<std::tuple_element_t<I, Dest_path>>();
+      invoke_on_entry(entered_state, evt, root);
+    }
+
+    template<std::size_t... Is>
+    static void enter_path(RootStateT& root, const Event& evt, std::index_sequence<Is...>)
+    {
+      (enter_on_path<lca_depth + Is>(root, evt), ...);
+    }
+
+    static bool try_execute(RootStateT& root, EventT&& evt)
+    {
+      if (!is_in_subtree<RootStateT, Src_state>(root.private_active_leaf_id)) {
+        return false;
+      }
+
+      auto& src_state = get_on_path<Src_path, std::tuple_size_v<Src_path>>(root);
+      Action_invocation<TransitionT>::invoke(src_state, std::as_const(evt), root);
+
+      if constexpr (!is_elided_exit_cascade_v<Exited_state, RootStateT, Event>) {
+        Iterative_steps<RootStateT, EventT>::exit_up_to(root, evt, state_id_v<RootStateT, Exited_state>);
+      }
+      enter_path(root, evt, std::make_index_sequence<std::tuple_size_v<Dest_path> - 1 - lca_depth>{});
+      Iterative_steps<RootStateT, EventT>::template enter_dest<Dest_state>(root, std::forward<EventT>(evt));
+      update_active_leaf(root, initial_leaf_id_v<RootStateT, Dest_state>);
+
+      return true;
+    }
+  };
+
+  // dispatches an event by walking the active path from the current innermost state up to the topmost
+  // state machine in a loop, looking up a transition step of each state on the path; if none is found,
+  // cross-level transitions triggered by the event are tried in order of declaration
+  template<typename RootStateT, typename EventT>
+  struct Iterative_dispatcher {
+    using Event = utils::remove_cvref_t<EventT>;
+    using Step_fn = bool (*)(RootStateT&, EventT&&);
+    using States = nested_states_t<RootStateT>;
+
+    template<typename StateT>
+    static constexpr Step_fn get_step()
+    {
+      if constexpr (Iterative_transition<RootStateT, EventT, StateT>::exists) {
+        return &Iterative_transition<RootStateT, EventT, StateT>::execute;
+      } else {
+        return nullptr;
+      }
+    }
+
+    template<std::size_t... Is>
+    static constexpr auto make_step_table(std::index_sequence<Is...>)
+    {
+      return std::array<Step_fn, sizeof...(Is)>{{get_step<std::tuple_element_t<Is, States>>()...}};
+    }
+
+    // gives steps of cross-level transitions triggered by the event
+    template<typename... TransitionTs>
+    static constexpr auto make_cross_step_table(std::tuple<TransitionTs...>*)
+    {
+      using Matching = utils::concat_t<std::conditional_t<std::is_same_v<get_tr_event<TransitionTs>, Event>,
+        std::tuple<TransitionTs>, std::tuple<>>...>;
+      return make_cross_steps(static_cast<Matching*>(nullptr));
+    }
+
+    template<typename... TransitionTs>
+    static constexpr auto make_cross_steps(std::tuple<TransitionTs...>*)
+    {
+      return std::array<Step_fn, sizeof...(TransitionTs)>{{&Iterative_cross_transition<RootStateT, EventT, TransitionTs>::try_execute...}};
+    }
+
+    static constexpr auto steps = make_step_table(std::make_index_sequence<state_count_v<RootStateT>>{});
+    static constexpr auto cross_steps = make_cross_step_table(static_cast<cross_transitions_t<RootStateT>*>(nullptr));
+
+    static bool dispatch(RootStateT& root, EventT&& evt)
+    {
+      for (State_id id = root.private_active_leaf_id; id != no_state_id; id = Hierarchy_links<RootStateT>::parents[id]) {
+        if (steps[id] != nullptr) {
+          return steps[id](root, std::forward<EventT>(evt));
+        }
+      }
+
+      // NOTE: a regular transition has not been taken; the event has not been moved from
+      for (const auto cross_step : cross_steps) {
+        if (cross_step(root, std::forward<EventT>(evt))) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+  };
+
+  // Compile-time tests
+  ////////////////////////////////////////////////////////////////////////////////
+
+  namespace Test::IterativeDispatchStackBound_FrameSizePassed_ReturnBoundIndependentOfDepth
+  {
+    static_assert(iterative_dispatch_stack_bound(96) == 96 * iterative_dispatch_call_depth);
+  }
+}
+
+#endif
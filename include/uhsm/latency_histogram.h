@@ -0,0 +1,119 @@
+#ifndef UHSM_LATENCY_HISTOGRAM_H_
+#define UHSM_LATENCY_HISTOGRAM_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "uhsm/utils.h"
+
+// NOTE: a fixed-size histogram with log-linear buckets; values below `sub_bucket_count` have
+// their own buckets, every power of two above is split into `sub_bucket_count` equal buckets,
+// so the relative error of a reported value does not exceed 1 / `sub_bucket_count`;
+// recording a value is a constant-time operation without any memory allocation
+
+namespace uhsm
+{
+  class Latency_histogram {
+  public:
+    static constexpr unsigned sub_bucket_bits = 3;
+    static constexpr std::size_t sub_bucket_count = std::size_t{1} << sub_bucket_bits;
+    static constexpr std::size_t bucket_count = (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+    static constexpr std::size_t bucket_idx(std::uint64_t value)
+    {
+      if (value < sub_bucket_count) {
+        return static_cast<std::size_t>(value);
+      }
+
+      const unsigned shift = utils::highest_bit_idx(value) - sub_bucket_bits;
+      return (shift + 1) * sub_bucket_count + ((value >> shift) & (sub_bucket_count - 1));
+    }
+
+    // gives the lowest value falling into a bucket
+    static constexpr std::uint64_t bucket_lower_bound(std::size_t idx)
+    {
+      if (idx < sub_bucket_count) {
+        return idx;
+      }
+
+      const std::size_t shift = idx / sub_bucket_count - 1;
+      return (sub_bucket_count + idx % sub_bucket_count) << shift;
+    }
+
+    // gives the highest value falling into a bucket
+    static constexpr std::uint64_t bucket_upper_bound(std::size_t idx)
+    {
+      return idx + 1 < bucket_count ? bucket_lower_bound(idx + 1) - 1 : UINT64_MAX;
+    }
+
+    void record(std::uint64_t value)
+    {
+      ++counts_[bucket_idx(value)];
+      ++total_count_;
+    }
+
+    void merge(const Latency_histogram& other)
+    {
+      for (std::size_t i = 0; i < bucket_count; ++i) {
+        counts_[i] += other.counts_[i];
+      }
+      total_count_ += other.total_count_;
+    }
+
+    void reset()
+    {
+      counts_ = {};
+      total_count_ = 0;
+    }
+
+    std::uint64_t total_count() const
+    {
+      return total_count_;
+    }
+
+    std::uint64_t bucket_value(std::size_t idx) const
+    {
+      return counts_[idx];
+    }
+
+    // gives an upper bound of values below which a given fraction (0.0-1.0) of recorded values falls
+    std::uint64_t percentile(double fraction) const
+    {
+      if (total_count_ == 0) {
+        return 0;
+      }
+
+      auto rank = static_cast<std::uint64_t>(fraction * static_cast<double>(total_count_));
+      rank = rank < total_count_ ? rank + 1 : total_count_;
+
+      std::uint64_t cumulative = 0;
+      for (std::size_t i = 0; i < bucket_count; ++i) {
+        cumulative += counts_[i];
+        if (cumulative >= rank) {
+          return bucket_upper_bound(i);
+        }
+      }
+
+      return bucket_upper_bound(bucket_count - 1);
+    }
+
+  private:
+    std::array<std::uint64_t, bucket_count> counts_{};
+    std::uint64_t total_count_ = 0;
+  };
+
+  // Compile-time tests
+  ////////////////////////////////////////////////////////////////////////////////
+
+  namespace Test::LatencyHistogram_ValuePassed_ReturnLogLinearBucket
+  {
+    static_assert(Latency_histogram::bucket_idx(7) == 7);
+    static_assert(Latency_histogram::bucket_idx(8) == 8 && Latency_histogram::bucket_idx(15) == 15);
+    static_assert(Latency_histogram::bucket_idx(16) == 16 && Latency_histogram::bucket_idx(17) == 16);
+    static_assert(Latency_histogram::bucket_idx(UINT64_MAX) == Latency_histogram::bucket_count - 1);
+    static_assert(Latency_histogram::bucket_lower_bound(Latency_histogram::bucket_idx(1000)) <= 1000);
+    static_assert(Latency_histogram::bucket_upper_bound(Latency_histogram::bucket_idx(1000)) >= 1000);
+  }
+}
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef UHSM_PROFILER_H_
+#define UHSM_PROFILER_H_
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "uhsm/helpers.h"
+#include "uhsm/latency_histogram.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define UHSM_HAS_TSC 1
+#endif
+
+// NOTE: an opt-in profiler of a state machine; the topmost state machine is profiled if it declares
+// a `uhsm::Profiler` data member named `profiler`, in which case durations of all on_entry/on_exit hooks,
+// (non-empty) actions and whole `react()` calls are recorded into log-linear histograms of a `Profile`;
+// a state machine which does not declare the member is not affected in any way
+// NOTE: hooks are measured individually, so the duration of a hook of a composite state does not
+// include hooks of its nested states; actions are recorded per transition (see `helpers::transition_id_v`),
+// so transitions sharing a source state are told apart
+
+namespace uhsm
+{
+  // a clock giving nanoseconds of `std::chrono::steady_clock`
+  struct Steady_clock_ticks {
+    static std::uint64_t now()
+    {
+      return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+  };
+
+#ifdef UHSM_HAS_TSC
+  // a clock giving the CPU time-stamp counter (cycles of a constant-rate TSC on modern x86 CPUs)
+  struct Tsc_ticks {
+    static std::uint64_t now()
+    {
+      return __rdtsc();
+    }
+  };
+#endif
+
+  // histograms of durations of all profiled invocations of a state machine
+  // NOTE: a profile is not synchronized; it is meant to be owned by a single thread (e.g. `thread_local`)
+  // and shared by all state machines run by the thread; profiles of multiple threads are combined
+  // with `merge()` once recorded, or handed over to an exporting thread by `Profile_exchange`
+  template<typename StateMachineT>
+  class Profile {
+  public:
+    static constexpr std::size_t state_count = helpers::state_count_v<StateMachineT>;
+    static constexpr std::size_t transition_count = helpers::transition_count_v<StateMachineT>;
+
+    void record(Profiled_hook hook, helpers::State_id id, std::uint64_t duration)
+    {
+      histogram(hook, id).record(duration);
+    }
+
+    // gives a histogram of invocations of a given kind for a state given by its global identifier
+    // (see `helpers::state_id_v`) or, for `Profiled_hook::action`, for a transition given by its global
+    // identifier (see `helpers::transition_id_v`); the identifier is ignored for `Profiled_hook::react`
+    Latency_histogram& histogram(Profiled_hook hook, helpers::State_id id)
+    {
+      return hook == Profiled_hook::react ? react_ :
+        hook == Profiled_hook::action ? actions_[id] : hooks_[static_cast<std::size_t>(hook)][id];
+    }
+    const Latency_histogram& histogram(Profiled_hook hook, helpers::State_id id) const
+    {
+      return hook == Profiled_hook::react ? react_ :
+        hook == Profiled_hook::action ? actions_[id] : hooks_[static_cast<std::size_t>(hook)][id];
+    }
+
+    // gives a histogram of on_entry or on_exit hooks of a state
+    template<typename StateT>
+    const Latency_histogram& histogram(Profiled_hook hook) const
+    {
+      assert(hook == Profiled_hook::entry || hook == Profiled_hook::exit);
+      return histogram(hook, helpers::state_id_v<StateMachineT, StateT>);
+    }
+
+    // gives a histogram of the action of the transition with a given source state triggered by a given event
+    // NOTE: a regular transition takes precedence over a cross-level one with the same source state and event
+    template<typename SrcStateT, typename EventT>
+    const Latency_histogram& action_histogram() const
+    {
+      constexpr std::size_t tr_id = helpers::find_tr_idx<SrcStateT, EventT>(
+        static_cast<helpers::all_transitions_t<StateMachineT>*>(nullptr));
+      static_assert(tr_id < transition_count, "No transition with the source state is triggered by the event");
+      return actions_[tr_id];
+    }
+
+    void merge(const Profile& other)
+    {
+      for (std::size_t hook = 0; hook < hooks_.size(); ++hook) {
+        for (std::size_t id = 0; id < state_count; ++id) {
+          hooks_[hook][id].merge(other.hooks_[hook][id]);
+        }
+      }
+      for (std::size_t id = 0; id < transition_count; ++id) {
+        actions_[id].merge(other.actions_[id]);
+      }
+      react_.merge(other.react_);
+    }
+
+    void reset()
+    {
+      for (auto& histograms : hooks_) {
+        for (auto& histogram : histograms) {
+          histogram.reset();
+        }
+      }
+      for (auto& histogram : actions_) {
+        histogram.reset();
+      }
+      react_.reset();
+    }
+
+  private:
+    // histograms of entry and exit hooks indexed by global state identifiers
+    std::array<std::array<Latency_histogram, state_count>, 2> hooks_;
+    // histograms of actions indexed by global transition identifiers
+    std::array<Latency_histogram, transition_count> actions_;
+    Latency_histogram react_;
+  };
+
+  // hands a profile recorded by one thread over to another thread (e.g. an exporter) without locks;
+  // the recording thread keeps recording into its own profile and from time to time publishes a copy
+  // of it, the exporting thread takes the latest published copy (e.g. to merge copies of all threads)
+  // NOTE: a single-producer, single-consumer triple buffer; each side owns one buffer and swaps it with
+  // the third one by a single atomic exchange, so both sides are wait-free, never touch a buffer owned
+  // by the other side, and recording itself involves no atomic operations
+  template<typename StateMachineT>
+  class Profile_exchange {
+  public:
+    // NOTE: called by the recording thread only
+    void publish(const Profile<StateMachineT>& profile)
+    {
+      buffers_[back_] = profile;
+      back_ = static_cast<std::uint8_t>(middle_.exchange(static_cast<std::uint8_t>(back_ | fresh), std::memory_order_acq_rel) & idx_mask);
+    }
+
+    // gives the most recently published profile (or the one taken last if none has been published since);
+    // the profile stays valid until the next call
+    // NOTE: called by the exporting thread only
+    const Profile<StateMachineT>& take()
+    {
+      if ((middle_.load(std::memory_order_relaxed) & fresh) != 0) {
+        front_ = static_cast<std::uint8_t>(middle_.exchange(front_, std::memory_order_acq_rel) & idx_mask);
+      }
+      return buffers_[front_];
+    }
+
+  private:
+    // the middle buffer has been published and not yet taken
+    static constexpr std::uint8_t fresh = 4;
+    static constexpr std::uint8_t idx_mask = 3;
+
+    std::array<Profile<StateMachineT>, 3> buffers_{};
+    // owned by the recording thread
+    std::uint8_t back_ = 0;
+    std::atomic<std::uint8_t> middle_{1};
+    // owned by the exporting thread
+    std::uint8_t front_ = 2;
+  };
+
+  // measures invocations of a state machine (a member `profiler` of the topmost state machine);
+  // nothing is recorded until a profile is attached
+  template<typename StateMachineT, typename ClockT = Steady_clock_ticks>
+  class Profiler {
+  public:
+    void attach(Profile<StateMachineT>* profile)
+    {
+      profile_ = profile;
+    }
+
+    void detach()
+    {
+      profile_ = nullptr;
+    }
+
+    // NOTE: called by the library around each profiled invocation
+    std::uint64_t start() const
+    {
+      return profile_ != nullptr ? ClockT::now() : 0;
+    }
+
+    void stop(Profiled_hook hook, helpers::State_id id, std::uint64_t start) const
+    {
+      if (profile_ != nullptr) {
+        profile_->record(hook, id, ClockT::now() - start);
+      }
+    }
+
+  private:
+    Profile<StateMachineT>* profile_ = nullptr;
+  };
+}
+
+#endif
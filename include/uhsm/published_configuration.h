@@ -0,0 +1,139 @@
+#ifndef UHSM_PUBLISHED_CONFIGURATION_H_
+#define UHSM_PUBLISHED_CONFIGURATION_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "uhsm/helpers.h"
+#include "uhsm/iterative_dispatch.h"
+
+// NOTE: an opt-in publication of the current configuration of a state machine for other threads;
+// the topmost state machine publishes its configuration if it declares a `uhsm::Published_configuration`
+// data member named `published_configuration`, in which case every change of the current innermost state
+// is stored (after all hooks of the transition have been invoked) into a single atomic word
+// NOTE: the whole configuration is determined by the identifier of the current innermost state, so
+// the word holds that identifier along with the number of publications; a snapshot is a single atomic
+// load, hence it is always consistent and wait-free, and the owning thread never blocks
+
+namespace uhsm::helpers
+{
+  // gives the version field (held in the upper bits of a word of a given type) following a given one;
+  // the field never becomes 0 (which stands for a state machine not yet started), so it wraps around to 1
+  template<typename WordT, unsigned IdBits>
+  constexpr WordT next_published_version(WordT version)
+  {
+    constexpr WordT max_version = static_cast<WordT>(~WordT{0}) >> IdBits;
+    return static_cast<WordT>(version % max_version + 1);
+  }
+
+  // Compile-time tests
+  ////////////////////////////////////////////////////////////////////////////////
+
+  namespace Test::NextPublishedVersion_MaxVersionPassed_WrapAroundToNonzero
+  {
+    static_assert(next_published_version<std::uint32_t, 16>(0) == 1);
+    static_assert(next_published_version<std::uint32_t, 16>(41) == 42);
+    static_assert(next_published_version<std::uint32_t, 16>(0xFFFE) == 0xFFFF);
+    static_assert(next_published_version<std::uint32_t, 16>(0xFFFF) == 1);
+    static_assert(next_published_version<std::uint64_t, 16>(0xFFFF) == 0x10000);
+  }
+}
+
+namespace uhsm
+{
+  // a configuration of a state machine taken at a single point in time
+  template<typename StateMachineT>
+  class Configuration_snapshot {
+  public:
+    static constexpr std::size_t max_depth = helpers::max_nesting_depth_v<StateMachineT>;
+
+    constexpr Configuration_snapshot() = default;
+    constexpr Configuration_snapshot(helpers::State_id leaf_id, std::uint64_t version) :
+      leaf_id_{leaf_id}, version_{version} {}
+
+    // gives the global identifier of the innermost state
+    constexpr helpers::State_id leaf_id() const
+    {
+      return leaf_id_;
+    }
+
+    // gives the number of configurations published before this one (0 for the configuration entered by `start()`)
+    // NOTE: the version wraps around to 0 after 2^48 - 1 publications (2^16 - 1 on targets
+    // without lock-free 64-bit atomics), so only differences of nearby versions are meaningful
+    constexpr std::uint64_t version() const
+    {
+      return version_;
+    }
+
+    template<typename StateT>
+    constexpr bool is_in() const
+    {
+      return helpers::is_in_subtree<StateMachineT, StateT>(leaf_id_);
+    }
+
+    // gives global identifiers of current states at each hierarchy level (from the outermost one);
+    // gives the number of levels
+    std::size_t state_ids(std::array<helpers::State_id, max_depth>& ids) const
+    {
+      std::size_t depth = 0;
+      for (auto id = leaf_id_; id != helpers::no_state_id; id = helpers::Hierarchy_links<StateMachineT>::parents[id]) {
+        ++depth;
+      }
+
+      auto id = leaf_id_;
+      for (std::size_t level = depth; level > 0; --level) {
+        ids[level - 1] = id;
+        id = helpers::Hierarchy_links<StateMachineT>::parents[id];
+      }
+      return depth;
+    }
+
+  private:
+    helpers::State_id leaf_id_ = 0;
+    std::uint64_t version_ = 0;
+  };
+
+  // the current configuration of a state machine (a member `published_configuration` of the topmost
+  // state machine) readable by any thread
+  // NOTE: written only by the thread dispatching events to the state machine
+  template<typename StateMachineT>
+  class Published_configuration {
+  public:
+    // NOTE: called by the library whenever the current innermost state changes
+    void publish(helpers::State_id leaf_id)
+    {
+      const auto version = helpers::next_published_version<Word, id_bits>(word_.load(std::memory_order_relaxed) >> id_bits);
+      word_.store(static_cast<Word>(version << id_bits | leaf_id), std::memory_order_release);
+    }
+
+    // NOTE: wait-free; may be called concurrently with `publish()`
+    Configuration_snapshot<StateMachineT> snapshot() const
+    {
+      const auto word = word_.load(std::memory_order_acquire);
+      // NOTE: the version is counted from the first publication (made by `start()`); the stored version
+      // is never 0 once published, even after wrapping around
+      return {static_cast<helpers::State_id>(word & id_mask), (word >> id_bits) - 1};
+    }
+
+    // checks if the state machine has been started
+    bool published() const
+    {
+      return (word_.load(std::memory_order_acquire) >> id_bits) != 0;
+    }
+
+  private:
+    // NOTE: a 32-bit word is used on targets without lock-free 64-bit atomics, in which case
+    // the version wraps around after 2^16 - 1 publications
+    using Word = std::conditional_t<std::atomic<std::uint64_t>::is_always_lock_free, std::uint64_t, std::uint32_t>;
+    static constexpr unsigned id_bits = 16;
+    static constexpr Word id_mask = (Word{1} << id_bits) - 1;
+    static_assert(sizeof(helpers::State_id) * 8 == id_bits);
+
+    // the version (the number of publications) in the upper bits, the innermost state in the lower bits
+    std::atomic<Word> word_{0};
+  };
+}
+
+#endif
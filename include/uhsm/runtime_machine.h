@@ -0,0 +1,375 @@
+#ifndef UHSM_RUNTIME_MACHINE_H_
+#define UHSM_RUNTIME_MACHINE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include "uhsm/helpers.h"
+
+// NOTE: a state machine interpreted at runtime from a binary description, with the same semantics
+// as a state machine defined at compile time (an event is handled by the innermost current state
+// having a matching transition, bubbling up to its ancestors; an internal transition only invokes
+// its action; otherwise the action is followed by on_exit from the innermost current state up to
+// the source state and by on_entry of the destination state and of its initial nested states;
+// `start()` enters initial states without invoking on_entry)
+// NOTE: binary format of a description (native byte order, 4-byte aligned, used in place):
+// - header (16 bytes): `Runtime_format::magic`, state count, initial state of the topmost level,
+//   transition count
+// - state records (16 bytes each) in depth-first pre-order (the order of global state identifiers
+//   of a compile-time state machine): parent state, initial nested state, entry and exit action
+//   identifiers, range of the state's transitions
+// - transition records (8 bytes each) grouped by their source state: event, dest. state, action
+// states, events and actions are referred to by 16-bit identifiers, `Runtime_format::no_id` stands
+// for none (no parent state, a simple state, no action); actions are C++ callables registered
+// by the user in a table indexed by action identifiers
+// NOTE: a description rejected by the constructor (see `loaded()`) is never accessed: `start()` fails
+// and the state machine, not being in any state, handles no events; a loaded description is trusted
+// by `start()`/`react()` unless checked by `validate()`
+
+namespace uhsm
+{
+  struct Runtime_format {
+    using Id = std::uint16_t;
+
+    static constexpr std::array<char, 8> magic = {{'U', 'H', 'S', 'M', 'R', 'T', 'M', '1'}};
+    static constexpr Id no_id = 0xFFFF;
+
+    struct Header {
+      std::array<char, 8> magic;
+      std::uint16_t state_count;
+      Id initial;
+      std::uint32_t transition_count;
+    };
+
+    struct State {
+      Id parent;
+      Id initial;
+      Id entry_action;
+      Id exit_action;
+      std::uint32_t first_transition;
+      std::uint16_t transition_count;
+      std::uint16_t reserved;
+    };
+
+    struct Transition {
+      Id event;
+      Id dest;
+      Id action;
+      std::uint16_t reserved;
+    };
+
+    static_assert(sizeof(Header) == 16 && sizeof(State) == 16 && sizeof(Transition) == 8);
+
+    static constexpr std::size_t size(std::size_t state_count, std::size_t transition_count)
+    {
+      return sizeof(Header) + state_count * sizeof(State) + transition_count * sizeof(Transition);
+    }
+  };
+
+  // an event passed to a runtime state machine: an identifier and an optional payload
+  struct Runtime_event {
+    Runtime_format::Id id;
+    const void* payload;
+  };
+
+  template<typename ContextT>
+  class Runtime_machine {
+  public:
+    using Id = Runtime_format::Id;
+    using Action = void (*)(ContextT& context, const Runtime_event& evt);
+
+    // NOTE: the description is used in place (e.g. a memory-mapped file), so it must outlive
+    // the state machine; only the header is checked here, see `validate()`
+    Runtime_machine(const void* description, std::size_t size, const Action* actions, std::size_t action_count,
+      ContextT& context)
+      : actions_{actions}, action_count_{action_count}, context_{&context}
+    {
+      if (size >= sizeof(Runtime_format::Header) &&
+        reinterpret_cast<std::uintptr_t>(description) % alignof(Runtime_format::Header) == 0) {
+        const auto* header = static_cast<const Runtime_format::Header*>(description);
+
+        if (header->magic == Runtime_format::magic &&
+          size == Runtime_format::size(header->state_count, header->transition_count)) {
+          header_ = header;
+          states_ = reinterpret_cast<const Runtime_format::State*>(header + 1);
+          transitions_ = reinterpret_cast<const Runtime_format::Transition*>(states_ + header->state_count);
+        }
+      }
+    }
+
+    // checks if the description has a valid header
+    bool loaded() const
+    {
+      return header_ != nullptr;
+    }
+
+    // checks that all identifiers within the description refer to existing states and registered actions
+    // and that the hierarchy is well-formed; a description which has not been validated (once, e.g.
+    // when it is produced) must be trusted
+    bool validate() const
+    {
+      if (!loaded() || header_->state_count == 0 || header_->state_count >= Runtime_format::no_id) {
+        return false;
+      }
+
+      const Id state_count = header_->state_count;
+      if (!is_state(header_->initial) || states_[header_->initial].parent != Runtime_format::no_id) {
+        return false;
+      }
+
+      for (Id id = 0; id < state_count; ++id) {
+        const auto& state = states_[id];
+        // NOTE: depth-first pre-order: a parent precedes its nested states
+        const bool valid_parent = state.parent == Runtime_format::no_id ||
+          (state.parent < id && states_[state.parent].initial != Runtime_format::no_id);
+        const bool valid_initial = state.initial == Runtime_format::no_id ||
+          (state.initial > id && is_state(state.initial) && states_[state.initial].parent == id);
+        const bool valid_range = state.first_transition <= header_->transition_count &&
+          state.transition_count <= header_->transition_count - state.first_transition;
+
+        if (!valid_parent || !valid_initial || !valid_range ||
+          !is_action(state.entry_action) || !is_action(state.exit_action)) {
+          return false;
+        }
+
+        for (std::uint32_t tr = state.first_transition; tr < state.first_transition + state.transition_count; ++tr) {
+          const auto& transition = transitions_[tr];
+          // NOTE: a transition connects states of the same hierarchy level
+          if (!is_state(transition.dest) || states_[transition.dest].parent != state.parent ||
+            !is_action(transition.action)) {
+            return false;
+          }
+        }
+      }
+
+      return true;
+    }
+
+    // enters the initial state of each hierarchy level; gives false (and the state machine stays
+    // not started) if the description has not been loaded
+    bool start()
+    {
+      if (!loaded()) {
+        return false;
+      }
+
+      leaf_ = innermost_initial(header_->initial);
+      return true;
+    }
+
+    // processes an event; gives false if the event cannot be handled in the current configuration
+    // (or if the state machine has not been started)
+    bool react(Id event, const void* payload = nullptr)
+    {
+      const Runtime_event evt{event, payload};
+
+      for (Id src = leaf_; src != Runtime_format::no_id; src = states_[src].parent) {
+        const auto& state = states_[src];
+
+        for (std::uint32_t tr = state.first_transition; tr < state.first_transition + state.transition_count; ++tr) {
+          if (transitions_[tr].event == event) {
+            take(src, transitions_[tr], evt);
+            return true;
+          }
+        }
+      }
+
+      return false;
+    }
+
+    // gives the identifier of the current innermost state
+    Id current_leaf_id() const
+    {
+      return leaf_;
+    }
+
+    // checks if a state (at any hierarchy level) is current
+    bool is_in(Id state) const
+    {
+      for (Id id = leaf_; id != Runtime_format::no_id; id = states_[id].parent) {
+        if (id == state) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+  private:
+    bool is_state(Id id) const
+    {
+      return id < header_->state_count;
+    }
+
+    bool is_action(Id id) const
+    {
+      return id == Runtime_format::no_id || id < action_count_;
+    }
+
+    void invoke(Id action, const Runtime_event& evt)
+    {
+      if (action != Runtime_format::no_id) {
+        actions_[action](*context_, evt);
+      }
+    }
+
+    Id innermost_initial(Id state) const
+    {
+      while (states_[state].initial != Runtime_format::no_id) {
+        state = states_[state].initial;
+      }
+      return state;
+    }
+
+    void take(Id src, const Runtime_format::Transition& transition, const Runtime_event& evt)
+    {
+      invoke(transition.action, evt);
+
+      if (transition.dest == src) {
+        // internal transition; do not call on_entry/on_exit
+        return;
+      }
+
+      // exit current states from the innermost one up to the source state
+      for (Id id = leaf_;; id = states_[id].parent) {
+        invoke(states_[id].exit_action, evt);
+        if (id == src) {
+          break;
+        }
+      }
+
+      // enter the dest. state and its initial nested states
+      Id id = transition.dest;
+      invoke(states_[id].entry_action, evt);
+      while (states_[id].initial != Runtime_format::no_id) {
+        id = states_[id].initial;
+        invoke(states_[id].entry_action, evt);
+      }
+      leaf_ = id;
+    }
+
+    const Runtime_format::Header* header_ = nullptr;
+    const Runtime_format::State* states_ = nullptr;
+    const Runtime_format::Transition* transitions_ = nullptr;
+    const Action* actions_;
+    std::size_t action_count_;
+    ContextT* context_;
+    Id leaf_ = Runtime_format::no_id;
+  };
+
+  namespace helpers
+  {
+    // appends types to a list, skipping `Empty_action` and types already in the list
+    template<typename ListT, typename... Ts>
+    struct append_unique_actions {
+      using type = ListT;
+    };
+    template<typename... ListTs, typename HeadT, typename... TailTs>
+    struct append_unique_actions<std::tuple<ListTs...>, HeadT, TailTs...> {
+      using type = typename append_unique_actions<std::conditional_t<
+        std::is_same_v<HeadT, Empty_action> || (std::is_same_v<HeadT, ListTs> || ...),
+        std::tuple<ListTs...>, std::tuple<ListTs..., HeadT>>, TailTs...>::type;
+    };
+  }
+
+  // converts a state machine defined at compile time into the binary description of a runtime state
+  // machine; events are identified by their indices within a given event list and actions by
+  // their indices within `Actions` (distinct action types in order of their first appearance)
+  // NOTE: only regular transitions are converted; hooks of states are not (they are not identified
+  // by types), so the entry/exit actions of all states are left empty
+  template<typename StateMachineT, typename... EventTs>
+  struct Runtime_description_of {
+    using Id = Runtime_format::Id;
+    using States = helpers::nested_states_t<StateMachineT>;
+    static constexpr std::size_t state_count = std::tuple_size_v<States>;
+
+    template<typename StateT>
+    static constexpr Id state_id = helpers::state_id_v<StateMachineT, StateT>;
+    template<typename EventT>
+    static constexpr Id event_id = static_cast<Id>(utils::tuple_elem_idx_v<EventT, std::tuple<EventTs...>>);
+
+    // all transitions of all hierarchy levels
+    template<typename... StateTs>
+    static auto collect_transitions(std::tuple<StateTs...>*) -> utils::concat_t<
+      typename StateMachineT::Transitions, typename helpers::level_transitions<StateTs>::type...>;
+    using Transitions = decltype(collect_transitions(static_cast<States*>(nullptr)));
+    static constexpr std::size_t transition_count = std::tuple_size_v<Transitions>;
+
+    template<typename... TransitionTs>
+    static auto collect_actions(std::tuple<TransitionTs...>*) -> typename helpers::append_unique_actions<
+      std::tuple<>, helpers::get_tr_action<TransitionTs>...>::type;
+    using Actions = decltype(collect_actions(static_cast<Transitions*>(nullptr)));
+
+    template<typename ActionT>
+    static constexpr Id action_id()
+    {
+      if constexpr (std::is_same_v<ActionT, Empty_action>) {
+        return Runtime_format::no_id;
+      } else {
+        return static_cast<Id>(utils::tuple_elem_idx_v<ActionT, Actions>);
+      }
+    }
+
+    // the description laid out as in a file
+    struct Image {
+      Runtime_format::Header header;
+      std::array<Runtime_format::State, state_count> states;
+      std::array<Runtime_format::Transition, transition_count> transitions;
+    };
+    static_assert(sizeof(Image) == Runtime_format::size(state_count, transition_count));
+
+    template<typename... StateTs, typename... TransitionTs>
+    static constexpr Image make(std::tuple<StateTs...>*, std::tuple<TransitionTs...>*)
+    {
+      Image image{};
+      image.header = {Runtime_format::magic, static_cast<std::uint16_t>(state_count),
+        state_id<typename StateMachineT::Initial>, static_cast<std::uint32_t>(transition_count)};
+
+      // NOTE: the parent of a state is the closest preceding state whose subtree contains it
+      constexpr std::size_t subtree_sizes[] = {helpers::subtree_size_v<StateTs>..., 0};
+      constexpr Id initials[] = {initial_of<StateTs>()..., 0};
+      for (std::size_t id = 0; id < state_count; ++id) {
+        image.states[id] = {Runtime_format::no_id, initials[id], Runtime_format::no_id, Runtime_format::no_id, 0, 0, 0};
+        for (std::size_t parent = id; parent-- > 0;) {
+          if (id < parent + subtree_sizes[parent]) {
+            image.states[id].parent = static_cast<Id>(parent);
+            break;
+          }
+        }
+      }
+
+      // transitions grouped by their source states, in the order of transition tables
+      constexpr Id srcs[] = {state_id<helpers::get_tr_src_state<TransitionTs>>..., 0};
+      constexpr Runtime_format::Transition records[] = {{event_id<helpers::get_tr_event<TransitionTs>>,
+        state_id<helpers::get_tr_dest_state<TransitionTs>>, action_id<helpers::get_tr_action<TransitionTs>>(), 0}...,
+        {0, 0, 0, 0}};
+      std::uint32_t next = 0;
+      for (std::size_t id = 0; id < state_count; ++id) {
+        image.states[id].first_transition = next;
+        for (std::size_t tr = 0; tr < transition_count; ++tr) {
+          if (srcs[tr] == id) {
+            image.transitions[next++] = records[tr];
+          }
+        }
+        image.states[id].transition_count = static_cast<std::uint16_t>(next - image.states[id].first_transition);
+      }
+
+      return image;
+    }
+
+    template<typename StateT>
+    static constexpr Id initial_of()
+    {
+      if constexpr (helpers::is_composite_state_v<StateT>) {
+        return state_id<typename StateT::Initial>;
+      } else {
+        return Runtime_format::no_id;
+      }
+    }
+
+    static constexpr Image image = make(static_cast<States*>(nullptr), static_cast<Transitions*>(nullptr));
+  };
+}
+
+#endif
@@ -8,6 +8,11 @@
 #include "uhsm/fwd.h"
 #include "uhsm/utils.h"
 #include "uhsm/helpers.h"
+#include "uhsm/compact_dispatch.h"
+#include "uhsm/cross_transition.h"
+#include "uhsm/flat_dispatch.h"
+#include "uhsm/iterative_dispatch.h"
+#include "uhsm/variant_dispatch.h"
 
 namespace uhsm
 { 
@@ -22,28 +27,28 @@ namespace uhsm
     using Parent = ParentStateT;
     
     template<typename EventT>
-    void on_entry(EventT&&) {}
+    constexpr Default_hook on_entry(EventT&&) { return {}; }
     template<typename EventT>
-    void on_exit(EventT&&) {}
+    constexpr Default_hook on_exit(EventT&&) { return {}; }
     
-    void start() {}
+    constexpr void start() {}
     
-    template<typename EventT>
-    void initialize(EventT&&)
+    template<typename EventT, typename RootStateT>
+    constexpr void initialize(EventT&&, RootStateT&)
     {
       // NOTE: nothing to be initialized in a simple state
       return;
     }
     
-    template<typename EventT>
-    void private_invoke_on_exit(EventT&& evt)
+    template<typename EventT, typename RootStateT>
+    constexpr void private_invoke_on_exit(EventT&& evt, RootStateT& root)
     {
       auto& derived = static_cast<T&>(*this); 
-      derived.on_exit(std::forward<EventT>(evt));
+      helpers::invoke_on_exit(derived, std::as_const(evt), root);
     }
     
-    template<typename EventT>
-    bool react(EventT&& evt)
+    template<typename EventT, typename RootStateT>
+    constexpr bool private_react(EventT&& evt, RootStateT& root)
     {
       // NOTE: an event can never be handled within a simple state
       return false;
@@ -51,7 +56,7 @@ namespace uhsm
   };
   
   template<typename T, typename ParentStateT>
-  struct State_machine_def {
+  struct State_machine_def : helpers::Root_data<ParentStateT> {
     using Parent = ParentStateT;
     
     template<typename U>
@@ -67,18 +72,18 @@ namespace uhsm
     using State_data_def = helpers::get_state_data_def_t<TransitionTableT>;
     
     template<typename U>
-    using State_set = helpers::extract_state_set_t<typename Derived_traits<U>::Transitions>;
+    using State_set = helpers::state_set_t<U>;
     template<typename U>
     using Transitions = typename Derived_traits<U>::Transitions;
     template<typename U>
     using Initial = typename Derived_traits<U>::Initial;
     
     template<typename EventT>
-    void on_entry(EventT&&) {}
+    constexpr Default_hook on_entry(EventT&&) { return {}; }
     template<typename EventT>
-    void on_exit(EventT&&) {}
+    constexpr Default_hook on_exit(EventT&&) { return {}; }
     
-    void start()
+    constexpr void start()
     {
       // WARNING: this member function MUST be called by the user on topmost
       // state machine object BEFORE any events are passed to it;
@@ -88,14 +93,31 @@ namespace uhsm
       // the state machine has direct storage;
       // TODO: add a flag indicating whether the complex state has been initialized
       // check it when processing an event and raise an exception if 
+      static_assert(helpers::check_storage_budget<T>::value, "State machine exceeds its storage budget");
 
       auto& state_data = (static_cast<T&>(*this)).state_data;
       state_data = Initial<T>{};
       (std::get<Initial<T>>(state_data)).start();
+      helpers::update_active_leaf(static_cast<T&>(*this), helpers::initial_leaf_id_v<T, T>);
     }
     
-    template<typename EventT>
-    void initialize(EventT&& evt)
+    // checks if a state (at any hierarchy level) is current; only for the topmost state machine
+    template<typename StateT>
+    constexpr bool is_in() const
+    {
+      static_assert(helpers::is_root_state_v<T>, "Configuration can only be queried on the topmost state machine");
+      return helpers::is_in_subtree<T, StateT>(this->private_active_leaf_id);
+    }
+    
+    // gives the global identifier of the current innermost state; only for the topmost state machine
+    constexpr helpers::State_id current_leaf_id() const
+    {
+      static_assert(helpers::is_root_state_v<T>, "Configuration can only be queried on the topmost state machine");
+      return this->private_active_leaf_id;
+    }
+    
+    template<typename EventT, typename RootStateT>
+    constexpr void initialize(EventT&& evt, RootStateT& root)
     {
       // NOTE: this member function is similar although it does not call on_entry functions
 
@@ -103,29 +125,97 @@ namespace uhsm
       state_data = Initial<T>{};
       
       auto& current_state = std::get<Initial<T>>(state_data);
-      current_state.on_entry(std::forward<EventT>(evt));
-      current_state.initialize(std::forward<EventT>(evt));
+      helpers::invoke_on_entry(current_state, std::forward<EventT>(evt), root);
+      current_state.initialize(std::forward<EventT>(evt), root);
     }
     
-    template<typename EventT>
-    void private_invoke_on_exit(EventT&& evt)
+    template<typename EventT, typename RootStateT>
+    constexpr void private_invoke_on_exit(EventT&& evt, RootStateT& root)
     {
       auto& derived = static_cast<T&>(*this);
-      helpers::invoke_private_exit_recur(derived.state_data, std::forward<EventT>(evt));
-      derived.on_exit(std::forward<EventT>(evt));
+      helpers::invoke_private_exit_recur(derived.state_data, std::as_const(evt), root);
+      helpers::invoke_on_exit(derived, std::as_const(evt), root);
     }
     
     template<typename EventT>
-    bool react(EventT&& evt)
+    constexpr bool react(EventT&& evt)
+    {
+      if constexpr (helpers::is_profiled_v<T>) {
+        auto& profiler = static_cast<T&>(*this).profiler;
+        const auto start = profiler.start();
+        const bool handled = private_dispatch(std::forward<EventT>(evt));
+        profiler.stop(Profiled_hook::react, 0, start);
+        return handled;
+      } else {
+        return private_dispatch(std::forward<EventT>(evt));
+      }
+    }
+    
+    // NOTE: processes an event passed down from the topmost state machine (`root`);
+    // not intended to be called by the user
+    template<typename EventT, typename RootStateT>
+    constexpr bool private_react(EventT&& evt, RootStateT& root)
     {
       static_assert(!helpers::has_ambiguous_trs_v<Transitions<T>>,
         "Transition table may not have ambiguous transitions");
       
-      auto& derived = static_cast<T&>(*this); 
-      const bool handled = helpers::Event_dispatcher<T, EventT, State_set<T>>::dispatch(
-        derived, std::forward<EventT>(evt));
+      auto& derived = static_cast<T&>(*this);
+      
+      if constexpr (helpers::dispatch_mode_v<RootStateT> == Dispatch_mode::compact) {
+        return helpers::Compact_dispatcher<T, EventT, RootStateT>::dispatch(
+          derived, std::forward<EventT>(evt), root);
+      } else {
+        const bool handled = helpers::Event_dispatcher<T, EventT, State_set<T>>::dispatch(
+          derived, std::forward<EventT>(evt), root);
+        
+        return handled;
+      }
+    }
+    
+    // NOTE: dispatches an event passed to `react()` of the topmost state machine;
+    // not intended to be called by the user
+    template<typename EventT>
+    constexpr bool private_dispatch(EventT&& evt)
+    {
+      auto& derived = static_cast<T&>(*this);
       
-      return handled;
+      if constexpr (helpers::is_event_variant_v<T, EventT>) {
+        static_assert(helpers::is_root_state_v<T>, "Variants of events can only be passed to the topmost state machine");
+        // NOTE: the held alternative is selected by its index (fused with the state tables in the flat and iterative modes)
+        if constexpr (helpers::dispatch_mode_v<T> == Dispatch_mode::flat || helpers::dispatch_mode_v<T> == Dispatch_mode::iterative) {
+          return helpers::Variant_dispatcher<T, EventT>::dispatch_fused(derived, std::forward<EventT>(evt));
+        } else {
+          return helpers::Variant_dispatcher<T, EventT>::dispatch(derived, std::forward<EventT>(evt));
+        }
+      } else if constexpr (helpers::dispatch_mode_v<T> == Dispatch_mode::flat &&
+        (helpers::handles_event_v<T, EventT> || helpers::has_cross_tr_w_event_v<T, EventT>)) {
+        static_assert(helpers::is_root_state_v<T>, "Flat dispatch can only be selected for the topmost state machine");
+        // NOTE: both regular and cross-level transitions are resolved by a single table lookup
+        return helpers::Flat_dispatcher<T, EventT>::dispatch(derived, std::forward<EventT>(evt));
+      } else if constexpr (helpers::dispatch_mode_v<T> == Dispatch_mode::iterative &&
+        (helpers::handles_event_v<T, EventT> || helpers::has_cross_tr_w_event_v<T, EventT>)) {
+        static_assert(helpers::is_root_state_v<T>, "Iterative dispatch can only be selected for the topmost state machine");
+        // NOTE: cross-level transitions are executed by the same loops as regular ones
+        return helpers::Iterative_dispatcher<T, EventT>::dispatch(derived, std::forward<EventT>(evt));
+      } else if constexpr (helpers::has_cross_tr_w_event_v<T, EventT>) {
+        static_assert(helpers::is_root_state_v<T>, "Cross-level transitions can only be declared in the topmost state machine");
+        
+        if constexpr (helpers::handles_event_v<T, EventT>) {
+          if (private_react(std::forward<EventT>(evt), derived)) {
+            return true;
+          }
+        }
+        // NOTE: a regular transition has not been taken; the event has not been moved from
+        return helpers::dispatch_cross_transition(derived, std::forward<EventT>(evt));
+      } else if constexpr (!helpers::handles_event_v<T, EventT>) {
+        // NOTE: no transition table within this state hierarchy refers to this event type;
+        // the event is ignored without any runtime dispatch
+        static_assert(!helpers::rejects_unhandled_events_v<T>,
+          "Event type is not handled by any state within the state machine");
+        return false;
+      } else {
+        return private_react(std::forward<EventT>(evt), derived);
+      }
     }
   };
   
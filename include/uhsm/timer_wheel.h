@@ -0,0 +1,265 @@
+#ifndef UHSM_TIMER_WHEEL_H_
+#define UHSM_TIMER_WHEEL_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "uhsm/utils.h"
+
+// NOTE: a timer service based on a hierarchical timing wheel; timers are intrusive nodes
+// (owned by states), so starting and cancelling a timer is a constant-time operation without
+// any memory allocation regardless of the number of armed timers; expired timers are delivered
+// as ordinary events into `react()` of a state machine
+// NOTE: time is measured in ticks of `Timer_wheel::advance()`, the wheel does not read any clock
+
+namespace uhsm
+{
+  template<typename StateMachineT>
+  class Timer_wheel;
+
+  // a link of a timer in a list of a timing wheel
+  class Timer_node {
+  public:
+    using Deliver_fn = void (*)(void* sm);
+
+    Timer_node() = default;
+    // NOTE: a copy of a timer is never armed
+    Timer_node(const Timer_node&) noexcept {}
+    Timer_node& operator=(const Timer_node&)
+    {
+      cancel();
+      return *this;
+    }
+
+    ~Timer_node()
+    {
+      cancel();
+    }
+
+    bool armed() const
+    {
+      return prev_ != nullptr;
+    }
+
+    void cancel()
+    {
+      if (armed()) {
+        prev_->next_ = next_;
+        next_->prev_ = prev_;
+        prev_ = next_ = nullptr;
+      }
+    }
+
+  private:
+    template<typename StateMachineT>
+    friend class Timer_wheel;
+
+    Timer_node* prev_ = nullptr;
+    Timer_node* next_ = nullptr;
+    std::uint64_t expiry_ = 0;
+    Deliver_fn deliver_ = nullptr;
+  };
+
+  // a timer which delivers an event of a given type once it expires; it is meant to be a member
+  // of a state, so it is cancelled automatically when the state is exited (the object of an exited
+  // state is destroyed right after its `on_exit`)
+  template<typename EventT>
+  class State_timer : public Timer_node {
+  public:
+    // (re)starts the timer to expire after a given number of ticks (at least 1)
+    template<typename StateMachineT>
+    void start(Timer_wheel<StateMachineT>& wheel, std::uint64_t delay)
+    {
+      wheel.schedule(*this, delay, &deliver<StateMachineT>);
+    }
+
+  private:
+    template<typename StateMachineT>
+    static void deliver(void* sm)
+    {
+      static_cast<StateMachineT*>(sm)->react(EventT{});
+    }
+  };
+
+  // NOTE: `level_count` levels of `slot_count` slots each; a timer is placed at the level given by
+  // the highest bit in which its expiry differs from the current time, and moved (cascaded) to lower
+  // levels as the time advances; timers expiring beyond the range of the wheel (2^32 ticks)
+  // are kept in an overflow list
+  template<typename StateMachineT>
+  class Timer_wheel {
+  public:
+    static constexpr unsigned level_bits = 8;
+    static constexpr std::size_t slot_count = std::size_t{1} << level_bits;
+    static constexpr unsigned level_count = 4;
+
+    // gives a level of a timer expiring at a given time (`level_count` for the overflow list)
+    static constexpr unsigned level_of(std::uint64_t expiry, std::uint64_t now)
+    {
+      const std::uint64_t diff = expiry ^ now;
+      if (diff < slot_count) {
+        return 0;
+      }
+
+      const unsigned level = utils::highest_bit_idx(diff) / level_bits;
+      return level < level_count ? level : level_count;
+    }
+
+    Timer_wheel()
+    {
+      for (auto& level : slots_) {
+        for (auto& slot : level) {
+          make_empty(slot);
+        }
+      }
+      make_empty(overflow_);
+    }
+
+    Timer_wheel(const Timer_wheel&) = delete;
+    Timer_wheel& operator=(const Timer_wheel&) = delete;
+
+    // NOTE: timers still armed are disarmed, so they may outlive the wheel
+    ~Timer_wheel()
+    {
+      for (auto& level : slots_) {
+        for (auto& slot : level) {
+          disarm_all(slot);
+        }
+      }
+      disarm_all(overflow_);
+    }
+
+    std::uint64_t now() const
+    {
+      return now_;
+    }
+
+    // (re)arms a timer to expire after a given number of ticks (at least 1)
+    void schedule(Timer_node& node, std::uint64_t delay, Timer_node::Deliver_fn deliver)
+    {
+      node.cancel();
+      node.expiry_ = now_ + (delay != 0 ? delay : 1);
+      node.deliver_ = deliver;
+      insert(node);
+    }
+
+    // advances the time by a given number of ticks, delivering expired timers to a state machine
+    // in order of their expiry; gives the number of delivered timers
+    // NOTE: a delivered event may start or cancel any timer (including the expiring ones)
+    std::size_t advance(StateMachineT& sm, std::uint64_t ticks = 1)
+    {
+      std::size_t count = 0;
+
+      for (; ticks != 0; --ticks) {
+        ++now_;
+        cascade();
+
+        Timer_node expired;
+        make_empty(expired);
+        splice(slots_[0][now_ & (slot_count - 1)], expired);
+
+        while (expired.next_ != &expired) {
+          Timer_node& node = *expired.next_;
+          node.cancel();
+          // NOTE: the owner of the node (and the node itself) may be destroyed during delivery
+          node.deliver_(&sm);
+          ++count;
+        }
+      }
+
+      return count;
+    }
+
+  private:
+    static void make_empty(Timer_node& list)
+    {
+      list.prev_ = list.next_ = &list;
+    }
+
+    static void push_back(Timer_node& list, Timer_node& node)
+    {
+      node.prev_ = list.prev_;
+      node.next_ = &list;
+      list.prev_->next_ = &node;
+      list.prev_ = &node;
+    }
+
+    // moves all nodes of a list to an empty list
+    static void splice(Timer_node& from, Timer_node& to)
+    {
+      if (from.next_ != &from) {
+        to.next_ = from.next_;
+        to.prev_ = from.prev_;
+        to.next_->prev_ = &to;
+        to.prev_->next_ = &to;
+        make_empty(from);
+      }
+    }
+
+    static void disarm_all(Timer_node& list)
+    {
+      while (list.next_ != &list) {
+        list.next_->cancel();
+      }
+    }
+
+    void insert(Timer_node& node)
+    {
+      const unsigned level = level_of(node.expiry_, now_);
+
+      if (level == level_count) {
+        push_back(overflow_, node);
+      } else {
+        push_back(slots_[level][(node.expiry_ >> (level * level_bits)) & (slot_count - 1)], node);
+      }
+    }
+
+    void reinsert_all(Timer_node& list)
+    {
+      Timer_node moved;
+      make_empty(moved);
+      splice(list, moved);
+
+      while (moved.next_ != &moved) {
+        Timer_node& node = *moved.next_;
+        node.cancel();
+        insert(node);
+      }
+    }
+
+    // moves timers of slots reached by the current time to lower levels, starting from the highest one
+    void cascade()
+    {
+      if ((now_ & ((std::uint64_t{1} << (level_count * level_bits)) - 1)) == 0) {
+        reinsert_all(overflow_);
+      }
+
+      for (unsigned level = level_count - 1; level > 0; --level) {
+        if ((now_ & ((std::uint64_t{1} << (level * level_bits)) - 1)) == 0) {
+          reinsert_all(slots_[level][(now_ >> (level * level_bits)) & (slot_count - 1)]);
+        }
+      }
+    }
+
+    // each slot is a circular list with a sentinel node
+    std::array<std::array<Timer_node, slot_count>, level_count> slots_;
+    Timer_node overflow_;
+    std::uint64_t now_ = 0;
+  };
+
+  // Compile-time tests
+  ////////////////////////////////////////////////////////////////////////////////
+
+  namespace Test::TimerWheelLevelOf_ExpiryPassed_ReturnLevel
+  {
+    struct Sm {};
+    using Wheel = Timer_wheel<Sm>;
+
+    static_assert(Wheel::level_of(255, 0) == 0);
+    static_assert(Wheel::level_of(256, 255) == 1);
+    static_assert(Wheel::level_of(0x10000, 0) == 2);
+    static_assert(Wheel::level_of(0xFFFFFFFF, 0) == 3);
+    static_assert(Wheel::level_of(0x100000000, 0) == Wheel::level_count);
+  }
+}
+
+#endif
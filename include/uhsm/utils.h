@@ -2,6 +2,7 @@
 #define UHSM_UTILS_H_
 
 #include <cassert>
+#include <cstdint>
 #include <type_traits>
 #include <tuple>
 #include <variant>
@@ -10,21 +11,14 @@
 
 namespace uhsm::utils
 { 
-  // checks if a std::tuple contains a type; assumes that it does not
-  // unless 'proven' otherwise
+  // checks if a std::tuple contains a type
+  // NOTE: implemented with a fold expression rather than by recursively peeling the tuple, so
+  // a single class is instantiated regardless of the tuple size
   template<typename MatchT, typename TupleT>
-  struct contains {
-    using type = std::false_type;
-  };
-  // matched type at tuple's head, true
-  template<typename HeadT, typename... TailTs>
-  struct contains<HeadT, std::tuple<HeadT, TailTs...>> {
-    using type = std::true_type;
-  };
-  // not matched at tuple's head, check the tail
-  template<typename MatchT, typename HeadT, typename... TailTs>
-  struct contains<MatchT, std::tuple<HeadT, TailTs...>> {
-    using type = typename contains<MatchT, std::tuple<TailTs...>>::type;
+  struct contains;
+  template<typename MatchT, typename... Ts>
+  struct contains<MatchT, std::tuple<Ts...>> {
+    using type = std::bool_constant<(std::is_same_v<MatchT, Ts> || ...)>;
   };
   
   template<typename MatchT, typename TupleT>
@@ -85,21 +79,48 @@ namespace uhsm::utils
   // helper typedef for `prepend`
   template<typename AddedT, typename TupleT>
   using prepend_t = typename prepend<AddedT, TupleT>::type;
+
+  // concatenates type lists of tuples into a single tuple
+  template<typename... TupleTs>
+  using concat_t = decltype(std::tuple_cat(std::declval<TupleTs>()...));
   
-  // gets an index of a type in a tuple's type list
-  template<size_t N, typename MatchT, typename TupleT>
-  struct tuple_elem_idx_impl;
-  template<size_t N, typename MatchT, typename... TailTs>
-  struct tuple_elem_idx_impl<N, MatchT, std::tuple<MatchT, TailTs...>>  {
-    static constexpr size_t value = N;
+  // strips references and cv-qualifiers (equivalent of C++20 `std::remove_cvref_t`)
+  template<typename T>
+  using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+  // checks if a predicate holds for at least one of tuple types
+  template<template<class> class Pred, typename TupleT>
+  struct any_of;
+  template<template<class> class Pred, typename... Ts>
+  struct any_of<Pred, std::tuple<Ts...>> {
+    static constexpr bool value = (Pred<Ts>::value || ...);
   };
-  template<size_t N, typename MatchT, typename HeadT, typename... TailTs>
-  struct tuple_elem_idx_impl<N, MatchT, std::tuple<HeadT, TailTs...>> {
-    static constexpr size_t value = tuple_elem_idx_impl<N + 1, MatchT, std::tuple<TailTs...>>::value;
+  // helper template variable for `any_of`
+  template<template<class> class Pred, typename TupleT>
+  inline constexpr bool any_of_v = any_of<Pred, TupleT>::value;
+  
+  // gets an index of a type in a tuple's type list (the first one if the type occurs more than once)
+  template<typename MatchT, typename TupleT>
+  struct tuple_elem_idx_impl;
+  template<typename MatchT, typename... Ts>
+  struct tuple_elem_idx_impl<MatchT, std::tuple<Ts...>> {
+    static constexpr size_t find()
+    {
+      constexpr bool matches[] = {std::is_same_v<MatchT, Ts>..., false};
+      
+      size_t idx = 0;
+      while (idx < sizeof...(Ts) && !matches[idx]) {
+        ++idx;
+      }
+      return idx;
+    }
+    
+    static constexpr size_t value = find();
+    static_assert(value < sizeof...(Ts), "Type is not an element of the tuple");
   };
   // helper template variable for `tuple_elem_idx_impl`
   template<typename MatchT, typename TupleT>
-  inline constexpr size_t tuple_elem_idx_v = tuple_elem_idx_impl<0, MatchT, TupleT>::value;
+  inline constexpr size_t tuple_elem_idx_v = tuple_elem_idx_impl<MatchT, TupleT>::value;
   
   // flattens a tuple of nested tuple by returning a single-dimensional tuple with 1st types of each of the nested tuples
   template<typename TupleT>
@@ -232,6 +253,30 @@ namespace uhsm::utils
     }
   };
   
+  // gives an index of the highest set bit (value must be non-zero)
+  constexpr unsigned highest_bit_idx(std::uint64_t value)
+  {
+#if defined(__GNUC__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+    unsigned idx = 0;
+    while (value >>= 1) {
+      ++idx;
+    }
+    return idx;
+#endif
+  }
+
+  // hints the processor to fetch memory at a given address into the cache (no-op if not supported)
+  inline void prefetch(const void* addr)
+  {
+#if defined(__GNUC__)
+    __builtin_prefetch(addr);
+#else
+    (void)addr;
+#endif
+  }
+
   // Compile-time tests
   ////////////////////////////////////////////////////////////////////////////////
   
@@ -255,6 +300,13 @@ namespace uhsm::utils
     >;
   }
   
+  namespace Test::HighestBitIdx_ValuePassed_ReturnMsbIdx
+  {
+    static_assert(highest_bit_idx(1) == 0);
+    static_assert(highest_bit_idx(0x90) == 7);
+    static_assert(highest_bit_idx(UINT64_MAX) == 63);
+  }
+  
   namespace Test::Contains_DoContain_ReturnTrue
   {
     using Bool_contains = contains_t<int, Test_data::Basic_tuple>;
@@ -300,6 +352,24 @@ namespace uhsm::utils
     static_assert(std::is_same_v<New_tuple, std::tuple<A, B, C>>);
   }
   
+  namespace Test::AnyOf_PredicateHoldsForSome_ReturnTrue
+  {
+    static_assert(any_of_v<std::is_floating_point, Test_data::Basic_tuple>);
+    static_assert(!any_of_v<std::is_pointer, Test_data::Basic_tuple>);
+  }
+
+  namespace Test::Concat_MultipleTuples_ReturnSingleTuple
+  {
+    using New_tuple = concat_t<std::tuple<bool>, std::tuple<>, std::tuple<int, float>>;
+    static_assert(std::is_same_v<New_tuple, Test_data::Basic_tuple>);
+  }
+  
+  namespace Test::RemoveCvref_QualifiedRef_ReturnPlainType
+  {
+    static_assert(std::is_same_v<remove_cvref_t<const int&>, int>);
+    static_assert(std::is_same_v<remove_cvref_t<int&&>, int>);
+  }
+
   namespace Test::TupleElemIdx_SimpleTuple_ReturnTypeIndex
   {
     struct A {};
@@ -0,0 +1,220 @@
+#ifndef UHSM_VARIANT_DISPATCH_H_
+#define UHSM_VARIANT_DISPATCH_H_
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <variant>
+#include "uhsm/helpers.h"
+#include "uhsm/cross_transition.h"
+#include "uhsm/flat_dispatch.h"
+#include "uhsm/iterative_dispatch.h"
+
+// NOTE: events passed to `react()` as a `std::variant` of event types are dispatched with tables indexed
+// by the index of the held alternative; with the flat dispatch mode the table is fused with the flat cell
+// tables, i.e. it is indexed by both the alternative and the current innermost state, so an event is dispatched
+// with a single lookup; with the iterative dispatch mode each alternative has its own row of transition steps
+// (indexed by state identifiers), so the active path is walked with a single lookup per level
+// NOTE: with the inlined and compact dispatch modes the event type and the states are not fused: the held
+// alternative is selected by its index (a single jump table once optimized) and then dispatched as if passed
+// to `react()` directly (as `std::visit` followed by `react()` would), i.e. by the regular per-level dispatch
+// of the mode; with the inlined mode this can be evaluated in a constant expression
+// NOTE: alternatives which the state machine does not handle are filtered out at compile time (their entries
+// only return false)
+
+namespace uhsm::helpers
+{
+  // checks if an event passed to `react()` is a variant of events rather than an event itself
+  // NOTE: a variant used as an event type in a transition table is dispatched as an event
+  template<typename RootStateT, typename EventT, typename = void>
+  struct is_event_variant : std::false_type {};
+  template<typename RootStateT, typename... EventTs>
+  struct is_event_variant<RootStateT, std::variant<EventTs...>>
+    : std::bool_constant<!handles_event_v<RootStateT, std::variant<EventTs...>> &&
+      !has_cross_tr_w_event_v<RootStateT, std::variant<EventTs...>>> {};
+  // helper variable template for `is_event_variant`; the variant type is taken without cv-qualifiers and references
+  template<typename RootStateT, typename EventT>
+  inline constexpr bool is_event_variant_v = is_event_variant<RootStateT, utils::remove_cvref_t<EventT>>::value;
+
+  // dispatches a variant of events (passed with a given value category) to the topmost state machine
+  template<typename RootStateT, typename VariantT>
+  struct Variant_dispatcher {
+    using Variant = utils::remove_cvref_t<VariantT>;
+    static constexpr std::size_t alternative_count = std::variant_size_v<Variant>;
+
+    // gives the type of an alternative as it would be deduced by `react()` for the variant's value category
+    template<std::size_t I>
+    using Alternative_fwd = std::conditional_t<std::is_rvalue_reference_v<VariantT&&>,
+      std::variant_alternative_t<I, Variant>,
+      decltype(std::get<I>(std::declval<VariantT&>()))>;
+
+    template<std::size_t I>
+    static constexpr bool handles_alternative = handles_event_v<RootStateT, Alternative_fwd<I>> ||
+      has_cross_tr_w_event_v<RootStateT, Alternative_fwd<I>>;
+
+    using Dispatch_fn = bool (*)(RootStateT&, VariantT&&);
+
+    static constexpr bool ignore(RootStateT&, VariantT&&)
+    {
+      return false;
+    }
+
+    template<std::size_t I>
+    static constexpr bool dispatch_alternative(RootStateT& root, VariantT&& evt)
+    {
+      if constexpr (handles_alternative<I>) {
+        return root.private_dispatch(std::get<I>(std::forward<VariantT>(evt)));
+      } else {
+        return false;
+      }
+    }
+
+    template<std::size_t I, typename LeafStateT>
+    static bool execute_cell(RootStateT& root, VariantT&& evt)
+    {
+      return Flat_cell<RootStateT, Alternative_fwd<I>, LeafStateT>::execute(root,
+        std::get<I>(std::forward<VariantT>(evt)));
+    }
+
+    template<std::size_t I, typename StateT>
+    static bool execute_step(RootStateT& root, VariantT&& evt)
+    {
+      return Iterative_transition<RootStateT, Alternative_fwd<I>, StateT>::execute(root,
+        std::get<I>(std::forward<VariantT>(evt)));
+    }
+
+    // tries cross-level transitions triggered by an alternative (in order of declaration)
+    template<std::size_t I>
+    static bool execute_cross_steps(RootStateT& root, VariantT&& evt)
+    {
+      for (const auto cross_step : Iterative_dispatcher<RootStateT, Alternative_fwd<I>>::cross_steps) {
+        if (cross_step(root, std::get<I>(std::forward<VariantT>(evt)))) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    template<std::size_t I, std::size_t J>
+    static constexpr Dispatch_fn get_cell()
+    {
+      using State = std::tuple_element_t<J, nested_states_t<RootStateT>>;
+
+      // NOTE: composite states are never the current innermost state
+      if constexpr (is_composite_state_v<State>) {
+        return &ignore;
+      } else if constexpr (Flat_cell<RootStateT, Alternative_fwd<I>, State>::handles_event) {
+        return &execute_cell<I, State>;
+      } else {
+        return &ignore;
+      }
+    }
+
+    template<std::size_t I, std::size_t J>
+    static constexpr Dispatch_fn get_step()
+    {
+      using State = std::tuple_element_t<J, nested_states_t<RootStateT>>;
+
+      if constexpr (Iterative_transition<RootStateT, Alternative_fwd<I>, State>::exists) {
+        return &execute_step<I, State>;
+      } else {
+        return nullptr;
+      }
+    }
+
+    template<std::size_t I, std::size_t... Js>
+    static constexpr auto make_cell_row(std::index_sequence<Js...>)
+    {
+      return std::array<Dispatch_fn, sizeof...(Js)>{{get_cell<I, Js>()...}};
+    }
+
+    template<std::size_t I, std::size_t... Js>
+    static constexpr auto make_step_row(std::index_sequence<Js...>)
+    {
+      return std::array<Dispatch_fn, sizeof...(Js)>{{get_step<I, Js>()...}};
+    }
+
+    template<std::size_t... Is>
+    static constexpr auto make_table(std::index_sequence<Is...>)
+    {
+      if constexpr (dispatch_mode_v<RootStateT> == Dispatch_mode::flat) {
+        return std::array<std::array<Dispatch_fn, state_count_v<RootStateT>>, sizeof...(Is)>{{
+          make_cell_row<Is>(std::make_index_sequence<state_count_v<RootStateT>>{})...}};
+      } else if constexpr (dispatch_mode_v<RootStateT> == Dispatch_mode::iterative) {
+        return std::array<std::array<Dispatch_fn, state_count_v<RootStateT>>, sizeof...(Is)>{{
+          make_step_row<Is>(std::make_index_sequence<state_count_v<RootStateT>>{})...}};
+      }
+    }
+
+    template<std::size_t... Is>
+    static constexpr auto make_cross_table(std::index_sequence<Is...>)
+    {
+      return std::array<Dispatch_fn, sizeof...(Is)>{{&execute_cross_steps<Is>...}};
+    }
+
+    // selects the held alternative by comparing its index (compiled into a jump table by optimizing
+    // compilers) rather than by a table kept in a static variable, so it can be evaluated in a constant expression
+    template<std::size_t... Is>
+    static constexpr bool dispatch_held(RootStateT& root, VariantT&& evt, std::index_sequence<Is...>)
+    {
+      bool handled = false;
+      static_cast<void>(((evt.index() == Is &&
+        (handled = dispatch_alternative<Is>(root, std::forward<VariantT>(evt)), true)) || ...));
+      return handled;
+    }
+
+    template<std::size_t... Is>
+    static constexpr bool handles_all(std::index_sequence<Is...>)
+    {
+      return (handles_alternative<Is> && ...);
+    }
+
+    // dispatches the held alternative with a table fused with the state tables (the flat and iterative modes)
+    static bool dispatch_fused(RootStateT& root, VariantT&& evt)
+    {
+      static_assert(!rejects_unhandled_events_v<RootStateT> ||
+        handles_all(std::make_index_sequence<alternative_count>{}),
+        "Event type is not handled by any state within the state machine");
+
+      static constexpr auto table = make_table(std::make_index_sequence<alternative_count>{});
+
+      if (evt.valueless_by_exception()) {
+        return false;
+      }
+
+      if constexpr (dispatch_mode_v<RootStateT> == Dispatch_mode::flat) {
+        return table[evt.index()][root.private_active_leaf_id](root, std::forward<VariantT>(evt));
+      } else {
+        static constexpr auto cross_table = make_cross_table(std::make_index_sequence<alternative_count>{});
+        const auto& steps = table[evt.index()];
+
+        for (State_id id = root.private_active_leaf_id; id != no_state_id; id = Hierarchy_links<RootStateT>::parents[id]) {
+          if (steps[id] != nullptr) {
+            return steps[id](root, std::forward<VariantT>(evt));
+          }
+        }
+
+        // NOTE: a regular transition has not been taken; the event has not been moved from
+        return cross_table[evt.index()](root, std::forward<VariantT>(evt));
+      }
+    }
+
+    // dispatches the held alternative as if passed to `react()` directly (the inlined and compact modes)
+    // NOTE: no table is kept in a static variable, so it can be evaluated in a constant expression
+    static constexpr bool dispatch(RootStateT& root, VariantT&& evt)
+    {
+      static_assert(!rejects_unhandled_events_v<RootStateT> ||
+        handles_all(std::make_index_sequence<alternative_count>{}),
+        "Event type is not handled by any state within the state machine");
+
+      if (evt.valueless_by_exception()) {
+        return false;
+      }
+
+      return dispatch_held(root, std::forward<VariantT>(evt), std::make_index_sequence<alternative_count>{});
+    }
+  };
+}
+
+#endif
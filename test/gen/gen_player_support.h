@@ -0,0 +1,26 @@
+#ifndef UHSM_TEST_GEN_PLAYER_SUPPORT_H_
+#define UHSM_TEST_GEN_PLAYER_SUPPORT_H_
+
+// NOTE: types referred to by the description of the generated test machine
+
+struct Gen_player_data {
+  int start_count;
+  bool led_on;
+};
+
+struct Led_hooks {
+  template<typename EventT>
+  void on_entry(Gen_player_data& context, const EventT&) { context.led_on = true; }
+  template<typename EventT>
+  void on_exit(Gen_player_data& context, const EventT&) { context.led_on = false; }
+};
+
+struct Count_start {
+  template<typename SrcStateT, typename EventT>
+  void operator()(Gen_player_data& context, SrcStateT&, const EventT&)
+  {
+    ++context.start_count;
+  }
+};
+
+#endif
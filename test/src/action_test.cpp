@@ -170,3 +170,67 @@ TEST(Action_TestGroup, React_InternalTrWithEventData0_InvokeActionHandlersPassDa
 
   mock().checkExpectations();
 }
+
+// a per-machine object accessible to transition actions
+struct Player_context {
+  int led_switch_count = 0;
+};
+
+namespace Action
+{
+  struct Count_led_switch {
+    template<typename SrcStateT, typename EventT>
+    void operator()(Player_context& context, SrcStateT& src_state, EventT&&)
+    {
+      ++context.led_switch_count;
+      ++src_state.action_count;
+    }
+  };
+}
+
+struct Player_w_context : uhsm::State_machine<Player_w_context> {
+  // NOTE: state objects are value-initialized when entered
+  struct Powered_off : Simple_state<Powered_off> {
+    int action_count;
+  };
+  struct Powered_on : Simple_state<Powered_on> {
+    int action_count;
+  };
+
+  using Initial = Powered_off;
+  using Transitions = Transition_table<
+    Transition<Powered_off, Event::Pwr_switch_flip, Powered_on, Action::Count_led_switch>,
+    Transition<Powered_on, Event::Pwr_switch_flip, Powered_off, Action::Count_led_switch>,
+    Transition<Powered_on, Event::Play_pause_btn, Powered_on, Action::Count_led_switch>
+  >;
+
+  State_data_def<Transitions> state_data;
+  Player_context context;
+};
+
+TEST(Action_TestGroup, React_ActionWithContext_ContextOfThisMachineModified)
+{
+  Player_w_context sm;
+  Player_w_context other_sm;
+  sm.start();   // initialized with 'Powered_off'
+  other_sm.start();
+
+  sm.react(Event::Pwr_switch_flip{});   // enters 'Powered_on'
+  sm.react(Event::Pwr_switch_flip{});   // enters 'Powered_off'
+  other_sm.react(Event::Pwr_switch_flip{});
+
+  LONGS_EQUAL(2, sm.context.led_switch_count);
+  LONGS_EQUAL(1, other_sm.context.led_switch_count);
+}
+
+TEST(Action_TestGroup, React_ActionWithContext_SourceStateModified)
+{
+  Player_w_context sm;
+  sm.start();   // initialized with 'Powered_off'
+
+  sm.react(Event::Pwr_switch_flip{});   // enters 'Powered_on'
+  sm.react(Event::Play_pause_btn{});    // remains in 'Powered_on', action modifies it
+  sm.react(Event::Play_pause_btn{});
+
+  LONGS_EQUAL(2, std::get<Player_w_context::Powered_on>(sm.state_data).action_count);
+}
@@ -0,0 +1,117 @@
+#include <CppUTest/TestHarness.h>
+#include <array>
+#include <memory>
+#include <type_traits>
+#include "uhsm/state_machine.h"
+#include "uhsm/any_state_machine.h"
+
+namespace Event
+{
+  struct Tick {};
+  struct Halt {};
+  struct Frame_received {
+    std::unique_ptr<int> payload;
+  };
+}
+
+struct Ticker : uhsm::State_machine<Ticker> {
+  struct Counting : Simple_state<Counting> {};
+  struct Halted : Simple_state<Halted> {};
+
+  struct Count {
+    template<typename SrcStateT, typename EventT>
+    void operator()(int& context, SrcStateT&, const EventT&)
+    {
+      ++context;
+    }
+  };
+
+  using Initial = Counting;
+  using Transitions = Transition_table<
+    Transition<Counting, Event::Tick, Counting, Count>,
+    Transition<Counting, Event::Halt, Halted>,
+    Transition<Halted, Event::Halt, Halted>
+  >;
+
+  State_data_def<Transitions> state_data;
+  int context;
+};
+
+struct Receiver : uhsm::State_machine<Receiver> {
+  struct Waiting : Simple_state<Waiting> {};
+  struct Received : Simple_state<Received> {
+    template<typename EventT>
+    void on_entry(int& context, EventT&& evt)
+    {
+      // NOTE: the event is passed with its original value category, so the sink may take ownership of it
+      if constexpr (std::is_const_v<std::remove_reference_t<EventT>>) {
+        context = *evt.payload;
+      } else {
+        auto payload = std::move(evt.payload);
+        context = *payload;
+      }
+    }
+  };
+
+  using Initial = Waiting;
+  using Transitions = Transition_table<
+    Transition<Waiting, Event::Frame_received, Received>,
+    Transition<Received, Event::Frame_received, Received>
+  >;
+
+  State_data_def<Transitions> state_data;
+  int context;
+};
+
+using Any_machine = uhsm::Any_state_machine<Event::Tick, Event::Halt, Event::Frame_received>;
+
+static_assert(sizeof(Any_machine) == 2 * sizeof(void*));
+static_assert(std::is_trivially_copyable_v<Any_machine>);
+
+TEST_GROUP(AnyStateMachine_TestGroup)
+{
+};
+
+TEST(AnyStateMachine_TestGroup, React_HeterogeneousMachines_EachMachineHandlesItsEvents)
+{
+  Ticker ticker{};
+  Receiver receiver{};
+  std::array<Any_machine, 2> machines{Any_machine{ticker}, Any_machine{receiver}};
+
+  for (auto& machine : machines) {
+    machine.start();
+  }
+
+  std::array<int, 2> handled{};
+  for (std::size_t idx = 0; idx < machines.size(); ++idx) {
+    handled[idx] += machines[idx].react(Event::Tick{});
+    handled[idx] += machines[idx].react(Event::Frame_received{std::make_unique<int>(7)});
+  }
+
+  LONGS_EQUAL(1, handled[0]);
+  LONGS_EQUAL(1, handled[1]);
+  LONGS_EQUAL(1, ticker.context);
+  LONGS_EQUAL(7, receiver.context);
+  CHECK(receiver.is_in<Receiver::Received>());
+  LONGS_EQUAL(receiver.current_leaf_id(), machines[1].current_leaf_id());
+}
+
+TEST(AnyStateMachine_TestGroup, React_EventIdPassed_EventDispatchedByItsId)
+{
+  Ticker ticker{};
+  Any_machine machine{ticker};
+  machine.start();
+
+  const Event::Halt halt{};
+  CHECK(machine.react(Any_machine::event_idx<Event::Halt>, &halt));
+  CHECK(ticker.is_in<Ticker::Halted>());
+}
+
+TEST(AnyStateMachine_TestGroup, Target_TypePassed_MachineGivenOnlyForItsType)
+{
+  Ticker ticker{};
+  Any_machine machine{ticker};
+
+  POINTERS_EQUAL(&ticker, machine.target<Ticker>());
+  POINTERS_EQUAL(nullptr, machine.target<Receiver>());
+}
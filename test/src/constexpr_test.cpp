@@ -0,0 +1,117 @@
+#include <CppUTest/TestHarness.h>
+#include <variant>
+#include "uhsm/state_machine.h"
+
+// NOTE: a state machine can only be run in a constant expression if `std::variant` assignment
+// is constexpr (C++20 with P2231); with an older standard library this file is empty
+#if defined(__cpp_lib_variant) && __cpp_lib_variant >= 202106L
+
+namespace Event
+{
+  struct Pwr_toggle {};
+  struct Go {};
+  struct Tick {
+    int count;
+  };
+}
+
+struct Tick_counter {
+  int ticks = 0;
+  int run_entries = 0;
+};
+
+namespace Action
+{
+  struct Add_ticks {
+    template<typename SrcStateT, typename EventT>
+    constexpr void operator()(Tick_counter& context, SrcStateT&, const EventT& evt)
+    {
+      context.ticks += evt.count;
+    }
+  };
+}
+
+struct Const_machine : uhsm::State_machine<Const_machine> {
+  struct Off : Simple_state<Off> {};
+
+  struct On : Substate_machine<On> {
+    struct Idle : Simple_state<Idle> {};
+    struct Running : Simple_state<Running> {
+      template<typename EventT>
+      constexpr void on_entry(Tick_counter& context, const EventT&) { ++context.run_entries; }
+    };
+
+    using Initial = Idle;
+    using Transitions = Transition_table<
+      Transition<Idle, Event::Go, Running>,
+      Transition<Running, Event::Tick, Running, Action::Add_ticks>
+    >;
+
+    State_data_def<Transitions> state_data;
+  };
+
+  using Initial = Off;
+  using Transitions = Transition_table<
+    Transition<Off, Event::Pwr_toggle, On>,
+    Transition<On, Event::Pwr_toggle, Off>
+  >;
+
+  State_data_def<Transitions> state_data;
+  Tick_counter context;
+};
+
+// a configuration reached by a fixed startup sequence, computed at compile time
+constexpr Const_machine startup_configuration = [] {
+  Const_machine sm{};
+  sm.start();
+  sm.react(Event::Pwr_toggle{});
+  sm.react(Event::Go{});
+  sm.react(Event::Tick{3});
+  return sm;
+}();
+
+namespace Test::ConstexprReact_StartupSequence_ConfigurationComputedAtCompileTime
+{
+  static_assert(startup_configuration.is_in<Const_machine::On::Running>());
+  static_assert(startup_configuration.context.ticks == 3);
+  static_assert(startup_configuration.context.run_entries == 1);
+}
+
+namespace Test::ConstexprReact_UnhandledEvent_ReturnFalse
+{
+  static_assert(![] {
+    Const_machine sm{};
+    sm.start();
+    return sm.react(Event::Go{});
+  }());
+}
+
+namespace Test::ConstexprReact_VariantOfEvents_HeldAlternativeDispatched
+{
+  using Any_event = std::variant<Event::Pwr_toggle, Event::Go, Event::Tick>;
+
+  static_assert([] {
+    Const_machine sm{};
+    sm.start();
+    const bool handled = sm.react(Any_event{Event::Pwr_toggle{}}) && sm.react(Any_event{Event::Go{}}) &&
+      sm.react(Any_event{Event::Tick{4}}) && !sm.react(Any_event{Event::Go{}});
+    return handled && sm.is_in<Const_machine::On::Running>() && sm.context.ticks == 4;
+  }());
+}
+
+TEST_GROUP(Constexpr_TestGroup)
+{
+};
+
+TEST(Constexpr_TestGroup, React_StartedFromCompileTimeConfiguration_ContinuesFromIt)
+{
+  Const_machine sm = startup_configuration;
+
+  sm.react(Event::Tick{2});
+  LONGS_EQUAL(5, sm.context.ticks);
+
+  sm.react(Event::Pwr_toggle{});
+  CHECK(sm.is_in<Const_machine::Off>());
+}
+
+#endif
@@ -0,0 +1,209 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+#include "uhsm/state_machine.h"
+
+namespace Event
+{
+  struct Pwr_switch_flip {};
+  struct Play_pause_btn {};
+  struct Stop_btn {};
+  struct Eject_btn {};
+  struct Resume_btn {};
+}
+
+namespace Action
+{
+  struct Release_disc {
+    template<typename SrcStateT, typename EventT>
+    void operator()(const SrcStateT&, EventT&&)
+    {
+      mock().actualCall("release_disc");
+    }
+  };
+}
+
+struct Cross_player : uhsm::State_machine<Cross_player> {
+  struct Powered_off : Simple_state<Powered_off> {
+    template<typename EventT>
+    void on_entry(EventT&&) { mock().actualCall("powered_off_ENTRY"); }
+    template<typename EventT>
+    void on_exit(EventT&&) { mock().actualCall("powered_off_EXIT"); }
+  };
+
+  struct Powered_on : Substate_machine<Powered_on> {
+    template<typename EventT>
+    void on_entry(EventT&&) { mock().actualCall("powered_on_ENTRY"); }
+    template<typename EventT>
+    void on_exit(EventT&&) { mock().actualCall("powered_on_EXIT"); }
+
+    struct Stopped : Simple_state<Stopped> {
+      template<typename EventT>
+      void on_entry(EventT&&) { mock().actualCall("stopped_ENTRY"); }
+      template<typename EventT>
+      void on_exit(EventT&&) { mock().actualCall("stopped_EXIT"); }
+    };
+
+    struct Active : Substate_machine<Active> {
+      template<typename EventT>
+      void on_entry(EventT&&) { mock().actualCall("active_ENTRY"); }
+      template<typename EventT>
+      void on_exit(EventT&&) { mock().actualCall("active_EXIT"); }
+
+      struct Playing : Simple_state<Playing> {
+        template<typename EventT>
+        void on_entry(EventT&&) { mock().actualCall("playing_ENTRY"); }
+        template<typename EventT>
+        void on_exit(EventT&&) { mock().actualCall("playing_EXIT"); }
+      };
+      struct Paused : Simple_state<Paused> {
+        template<typename EventT>
+        void on_entry(EventT&&) { mock().actualCall("paused_ENTRY"); }
+        template<typename EventT>
+        void on_exit(EventT&&) { mock().actualCall("paused_EXIT"); }
+      };
+
+      using Initial = Playing;
+      using Transitions = Transition_table<
+        Transition<Playing, Event::Play_pause_btn, Paused>,
+        Transition<Paused, Event::Play_pause_btn, Playing>
+      >;
+
+      State_data_def<Transitions> state_data;
+    };
+
+    using Initial = Stopped;
+    using Transitions = Transition_table<
+      Transition<Stopped, Event::Play_pause_btn, Active>,
+      Transition<Active, Event::Stop_btn, Stopped>
+    >;
+
+    State_data_def<Transitions> state_data;
+  };
+
+  using Initial = Powered_off;
+  using Transitions = Transition_table<
+    Transition<Powered_off, Event::Pwr_switch_flip, Powered_on>,
+    Transition<Powered_on, Event::Pwr_switch_flip, Powered_off>
+  >;
+  using Cross_transitions = Transition_table<
+    Transition<Powered_on::Active::Paused, Event::Eject_btn, Powered_off, Action::Release_disc>,
+    Transition<Powered_on::Stopped, Event::Resume_btn, Powered_on::Active::Paused>,
+    Transition<Powered_off, Event::Resume_btn, Powered_on::Active::Paused>,
+    Transition<Powered_on::Active::Playing, Event::Stop_btn, Powered_off>
+  >;
+
+  State_data_def<Transitions> state_data;
+};
+
+TEST_GROUP(CrossTransition_TestGroup)
+{
+  void teardown()
+  {
+    mock().clear();
+  }
+};
+
+TEST(CrossTransition_TestGroup, React_DeepToShallowTr_ExitUpToLcaInOrder)
+{
+  Cross_player sm;
+  sm.start();   // initialized with 'Powered_off'
+  mock().disable();
+  sm.react(Event::Pwr_switch_flip{});   // enters 'Powered_on::Stopped'
+  sm.react(Event::Play_pause_btn{});    // enters 'Powered_on::Active::Playing'
+  sm.react(Event::Play_pause_btn{});    // enters 'Powered_on::Active::Paused'
+  mock().enable();
+
+  mock().strictOrder();
+  mock().expectOneCall("release_disc");
+  mock().expectOneCall("paused_EXIT");
+  mock().expectOneCall("active_EXIT");
+  mock().expectOneCall("powered_on_EXIT");
+  mock().expectOneCall("powered_off_ENTRY");
+
+  const bool handled = sm.react(Event::Eject_btn{});    // enters 'Powered_off'
+
+  mock().checkExpectations();
+  CHECK(handled);
+
+  const bool in_state = uhsm::helpers::is_in_state<
+  Cross_player,
+  Cross_player::Powered_off>(sm);
+  CHECK(in_state);
+  CHECK(sm.is_in<Cross_player::Powered_off>());
+}
+
+TEST(CrossTransition_TestGroup, React_ShallowToDeepTr_EnterPathInOrder)
+{
+  Cross_player sm;
+  sm.start();   // initialized with 'Powered_off'
+
+  mock().strictOrder();
+  mock().expectOneCall("powered_off_EXIT");
+  mock().expectOneCall("powered_on_ENTRY");
+  mock().expectOneCall("active_ENTRY");
+  mock().expectOneCall("paused_ENTRY");
+
+  const bool handled = sm.react(Event::Resume_btn{});   // enters 'Powered_on::Active::Paused'
+
+  mock().checkExpectations();
+  CHECK(handled);
+
+  const bool in_state = uhsm::helpers::is_in_state<
+  Cross_player,
+  Cross_player::Powered_on,
+  Cross_player::Powered_on::Active,
+  Cross_player::Powered_on::Active::Paused>(sm);
+  CHECK(in_state);
+  CHECK(sm.is_in<Cross_player::Powered_on::Active::Paused>());
+}
+
+TEST(CrossTransition_TestGroup, React_TrWithinCommonAncestor_AncestorNotExited)
+{
+  Cross_player sm;
+  sm.start();   // initialized with 'Powered_off'
+  mock().disable();
+  sm.react(Event::Pwr_switch_flip{});   // enters 'Powered_on::Stopped'
+  mock().enable();
+
+  mock().strictOrder();
+  mock().expectOneCall("stopped_EXIT");
+  mock().expectOneCall("active_ENTRY");
+  mock().expectOneCall("paused_ENTRY");
+  mock().expectNoCall("powered_on_EXIT");
+  mock().expectNoCall("powered_on_ENTRY");
+
+  sm.react(Event::Resume_btn{});    // enters 'Powered_on::Active::Paused'
+
+  mock().checkExpectations();
+  CHECK(sm.is_in<Cross_player::Powered_on::Active::Paused>());
+}
+
+TEST(CrossTransition_TestGroup, React_SrcStateNotCurrent_EventIgnored)
+{
+  Cross_player sm;
+  sm.start();   // initialized with 'Powered_off'
+  mock().disable();
+  sm.react(Event::Pwr_switch_flip{});   // enters 'Powered_on::Stopped'
+  sm.react(Event::Play_pause_btn{});    // enters 'Powered_on::Active::Playing'
+  mock().enable();
+
+  const bool handled = sm.react(Event::Resume_btn{});
+
+  CHECK_FALSE(handled);
+  CHECK(sm.is_in<Cross_player::Powered_on::Active::Playing>());
+}
+
+TEST(CrossTransition_TestGroup, React_RegularTrAvailable_RegularTrTaken)
+{
+  Cross_player sm;
+  sm.start();   // initialized with 'Powered_off'
+  mock().disable();
+  sm.react(Event::Pwr_switch_flip{});   // enters 'Powered_on::Stopped'
+  sm.react(Event::Play_pause_btn{});    // enters 'Powered_on::Active::Playing'
+
+  // NOTE: both the regular transition of 'Active' and the cross-level transition of 'Playing'
+  // are triggered by the event; the regular transition takes precedence
+  sm.react(Event::Stop_btn{});          // enters 'Powered_on::Stopped'
+
+  CHECK(sm.is_in<Cross_player::Powered_on::Stopped>());
+}
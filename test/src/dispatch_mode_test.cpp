@@ -0,0 +1,160 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+#include <type_traits>
+#include "uhsm/state_machine.h"
+#include "mode_player.h"
+
+// NOTE: the order of hook invocations does not depend on the dispatch mode, so each test is run
+// with the player in each mode
+
+template<uhsm::Dispatch_mode ModeV>
+using Mode = std::integral_constant<uhsm::Dispatch_mode, ModeV>;
+
+TEST_GROUP(DispatchMode_TestGroup)
+{
+  void teardown()
+  {
+    mock().clear();
+  }
+
+  // runs a test (a generic callable taking the mode as an integral constant) for each dispatch mode
+  template<typename TestT>
+  void for_each_mode(TestT test)
+  {
+    test(Mode<uhsm::Dispatch_mode::inlined>{});
+    mock().clear();
+    test(Mode<uhsm::Dispatch_mode::compact>{});
+    mock().clear();
+    test(Mode<uhsm::Dispatch_mode::flat>{});
+    mock().clear();
+    test(Mode<uhsm::Dispatch_mode::iterative>{});
+  }
+
+  template<uhsm::Dispatch_mode ModeV>
+  void react_cascade_in_tr()
+  {
+    using Player = Mode_player<ModeV>;
+
+    Player sm;
+    sm.start();   // initialized with 'Powered_off'
+
+    mock().strictOrder();
+    mock().expectOneCall("turn_led_on");
+    mock().expectOneCall("powered_off_EXIT");
+    mock().expectOneCall("powered_on_ENTRY");
+    mock().expectOneCall("stopped_ENTRY");
+    mock().expectOneCall("stopped_EXIT");
+    mock().expectOneCall("active_ENTRY");
+    mock().expectOneCall("playing_ENTRY");
+
+    sm.react(Event::Pwr_switch_flip{});   // enters 'Powered_on::Stopped', invokes 'turn_led_on' action
+    sm.react(Event::Play_pause_btn{});    // enters 'Powered_on::Active::Playing'
+
+    mock().checkExpectations();
+
+    const bool in_state = uhsm::helpers::is_in_state<
+    Player,
+    typename Player::Powered_on,
+    typename Player::Powered_on::Active,
+    typename Player::Powered_on::Active::Playing>(sm);
+    CHECK(in_state);
+  }
+
+  template<uhsm::Dispatch_mode ModeV>
+  void react_cascade_out_tr()
+  {
+    using Player = Mode_player<ModeV>;
+
+    Player sm;
+    sm.start();   // initialized with 'Powered_off'
+    mock().disable();
+    sm.react(Event::Pwr_switch_flip{});   // enters 'Powered_on::Stopped'
+    sm.react(Event::Play_pause_btn{});    // enters 'Powered_on::Active::Playing'
+    mock().enable();
+
+    mock().strictOrder();
+    mock().expectOneCall("playing_EXIT");
+    mock().expectOneCall("active_EXIT");
+    mock().expectOneCall("powered_on_EXIT");
+
+    sm.react(Event::Pwr_switch_flip{});   // leaves 'Powered_on' substate, enters 'Powered_off'
+
+    mock().checkExpectations();
+
+    const bool in_state = uhsm::helpers::is_in_state<
+    Player,
+    typename Player::Powered_off>(sm);
+    CHECK(in_state);
+  }
+
+  template<uhsm::Dispatch_mode ModeV>
+  void react_internal_tr()
+  {
+    using Player = Mode_player<ModeV>;
+
+    Player sm;
+    sm.start();   // initialized with 'Powered_off'
+    mock().disable();
+    sm.react(Event::Pwr_switch_flip{});   // enters 'Powered_on::Stopped'
+    sm.react(Event::Play_pause_btn{});    // enters 'Powered_on::Active::Playing'
+    sm.react(Event::Play_pause_btn{});    // enters 'Powered_on::Active::Paused'
+    mock().enable();
+
+    mock().expectOneCall("playback_pos_forward");
+    mock().expectNoCall("active_EXIT");
+    mock().expectNoCall("active_ENTRY");
+
+    const bool handled = sm.react(Event::Forward_btn{});   // remains in 'Powered_on::Active::Paused'
+
+    mock().checkExpectations();
+    CHECK(handled);
+
+    const bool in_state = uhsm::helpers::is_in_state<
+    Player,
+    typename Player::Powered_on,
+    typename Player::Powered_on::Active,
+    typename Player::Powered_on::Active::Paused>(sm);
+    CHECK(in_state);
+    CHECK(sm.template is_in<typename Player::Powered_on::Active::Paused>());
+  }
+
+  template<uhsm::Dispatch_mode ModeV>
+  void react_unsupported_event()
+  {
+    using Player = Mode_player<ModeV>;
+
+    Player sm;
+    sm.start();   // initialized with 'Powered_off'
+
+    const bool play_pause_btn_handled = sm.react(Event::Play_pause_btn{});
+    const bool stop_btn_handled = sm.react(Event::Stop_btn{});
+
+    CHECK_FALSE(play_pause_btn_handled);
+    CHECK_FALSE(stop_btn_handled);
+
+    const bool in_state = uhsm::helpers::is_in_state<
+    Player,
+    typename Player::Powered_off>(sm);
+    CHECK(in_state);
+  }
+};
+
+TEST(DispatchMode_TestGroup, React_CascadeInTr1_InvokeHooksInOrder)
+{
+  for_each_mode([this](auto mode) { react_cascade_in_tr<decltype(mode)::value>(); });
+}
+
+TEST(DispatchMode_TestGroup, React_CascadeOutTr1_InvokeHooksInOrder)
+{
+  for_each_mode([this](auto mode) { react_cascade_out_tr<decltype(mode)::value>(); });
+}
+
+TEST(DispatchMode_TestGroup, React_InternalTr_RemainInStateInvokeAction)
+{
+  for_each_mode([this](auto mode) { react_internal_tr<decltype(mode)::value>(); });
+}
+
+TEST(DispatchMode_TestGroup, React_UnsupportedEventPassed_EventIgnored)
+{
+  for_each_mode([this](auto mode) { react_unsupported_event<decltype(mode)::value>(); });
+}
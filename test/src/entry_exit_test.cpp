@@ -158,3 +158,63 @@ TEST(EntryExit_TestGroup, React_InternalCascadeOutTr0_InvokeEntryExitInOrder)
 
   mock().checkExpectations();
 }
+
+// a state machine whose 'Running' branch declares no hooks except for its deepest state
+struct Partly_hooked : uhsm::State_machine<Partly_hooked> {
+  struct Idle : Simple_state<Idle> {};
+
+  struct Running : Substate_machine<Running> {
+    struct Warming_up : Simple_state<Warming_up> {};
+
+    struct Working : Substate_machine<Working> {
+      struct Busy : Simple_state<Busy> {
+        template<typename EventT>
+        void on_exit(EventT&&) { mock().actualCall("busy_EXIT"); }
+      };
+
+      using Initial = Busy;
+      using Transitions = Transition_table<
+        Transition<Busy, Event::Forward_btn, Busy>
+      >;
+
+      State_data_def<Transitions> state_data;
+    };
+
+    using Initial = Warming_up;
+    using Transitions = Transition_table<
+      Transition<Warming_up, Event::Play_pause_btn, Working>,
+      Transition<Working, Event::Forward_btn, Working>
+    >;
+
+    State_data_def<Transitions> state_data;
+  };
+
+  using Initial = Idle;
+  using Transitions = Transition_table<
+    Transition<Idle, Event::Pwr_switch_flip, Running>,
+    Transition<Running, Event::Stop_btn, Idle>
+  >;
+
+  State_data_def<Transitions> state_data;
+};
+
+// NOTE: default hooks are elided; a subtree is exited without visiting its current states only
+// if none of its states declares on_exit
+static_assert(uhsm::helpers::is_elided_exit_cascade_v<Partly_hooked::Running::Warming_up, Partly_hooked, Event::Stop_btn>);
+static_assert(!uhsm::helpers::is_elided_exit_cascade_v<Partly_hooked::Running, Partly_hooked, Event::Stop_btn>);
+static_assert(!uhsm::helpers::is_elided_exit_cascade_v<Player_w_entry_exit::Powered_off, Player_w_entry_exit, Event::Stop_btn>);
+
+TEST(EntryExit_TestGroup, React_DefaultHooksElided_DeclaredHooksInvoked)
+{
+  Partly_hooked sm;
+  sm.start();   // initialized with 'Idle'
+  sm.react(Event::Pwr_switch_flip{});   // enters 'Running::Warming_up'
+  sm.react(Event::Play_pause_btn{});    // enters 'Running::Working::Busy'
+
+  mock().expectOneCall("busy_EXIT");
+
+  sm.react(Event::Stop_btn{});          // enters 'Idle'
+
+  mock().checkExpectations();
+  CHECK(sm.is_in<Partly_hooked::Idle>());
+}
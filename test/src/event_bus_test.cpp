@@ -0,0 +1,91 @@
+#include <CppUTest/TestHarness.h>
+#include "uhsm/state_machine.h"
+#include "uhsm/event_bus.h"
+
+namespace Event
+{
+  struct Clock_tick {};
+  struct Config_update {};
+  struct Arm {};
+  struct Disarm {};
+}
+
+struct Sensor : uhsm::State_machine<Sensor> {
+  struct Disarmed : Simple_state<Disarmed> {};
+
+  struct Armed : Substate_machine<Armed> {
+    struct Sampling : Simple_state<Sampling> {};
+
+    using Initial = Sampling;
+    using Transitions = Transition_table<
+      Transition<Sampling, Event::Clock_tick, Sampling>
+    >;
+
+    State_data_def<Transitions> state_data;
+  };
+
+  using Initial = Disarmed;
+  using Transitions = Transition_table<
+    Transition<Disarmed, Event::Arm, Armed>,
+    Transition<Armed, Event::Config_update, Armed>,
+    Transition<Armed, Event::Disarm, Disarmed>
+  >;
+
+  State_data_def<Transitions> state_data;
+};
+
+using Sensor_bus = uhsm::Event_bus<Sensor, Event::Clock_tick, Event::Config_update, Event::Arm>;
+
+namespace Test::SubscriptionMask_NestedState_IncludesAncestorEvents
+{
+  using Masks = uhsm::helpers::Subscription_masks<Sensor, Event::Clock_tick, Event::Config_update, Event::Arm>;
+  using uhsm::helpers::state_id_v;
+
+  static_assert(Masks::table[state_id_v<Sensor, Sensor::Disarmed>] == 0b100);
+  static_assert(Masks::table[state_id_v<Sensor, Sensor::Armed::Sampling>] == 0b011);
+}
+
+TEST_GROUP(EventBus_TestGroup)
+{
+};
+
+TEST(EventBus_TestGroup, Publish_MembersInDifferentStates_OnlySubscribedMembersReact)
+{
+  Sensor_bus bus;
+  Sensor_bus::Member members[3];
+  for (auto& member : members) {
+    member.sm.start();
+    bus.join(member);
+  }
+  members[1].react(Event::Arm{});
+
+  LONGS_EQUAL(1, bus.subscriber_count<Event::Clock_tick>());
+  LONGS_EQUAL(2, bus.subscriber_count<Event::Arm>());
+
+  LONGS_EQUAL(1, bus.publish(Event::Clock_tick{}));
+  CHECK(members[1].sm.is_in<Sensor::Armed::Sampling>());
+  CHECK(members[0].sm.is_in<Sensor::Disarmed>());
+}
+
+TEST(EventBus_TestGroup, Publish_MemberChangesConfiguration_SubscriptionsUpdated)
+{
+  Sensor_bus bus;
+  Sensor_bus::Member members[2];
+  for (auto& member : members) {
+    member.sm.start();
+    bus.join(member);
+  }
+
+  LONGS_EQUAL(2, bus.publish(Event::Arm{}));
+  LONGS_EQUAL(0, bus.subscriber_count<Event::Arm>());
+  LONGS_EQUAL(2, bus.subscriber_count<Event::Clock_tick>());
+
+  // NOTE: 'Disarm' is not an event of the bus; it is passed to a member directly
+  members[0].react(Event::Disarm{});
+  LONGS_EQUAL(1, bus.subscriber_count<Event::Clock_tick>());
+  LONGS_EQUAL(0b100, members[0].subscriptions());
+
+  bus.leave(members[1]);
+  LONGS_EQUAL(0, bus.publish(Event::Clock_tick{}));
+  LONGS_EQUAL(0, members[1].subscriptions());
+}
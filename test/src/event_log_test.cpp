@@ -0,0 +1,125 @@
+#include <CppUTest/TestHarness.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "uhsm/state_machine.h"
+#include "uhsm/event_log.h"
+#include "uhsm/latency_histogram.h"
+
+namespace Event
+{
+  struct Pwr_switch_flip {};
+  struct Play_pause_btn {};
+  struct Volume_set {
+    std::uint8_t level;
+  };
+}
+
+struct Logged_player : uhsm::State_machine<Logged_player> {
+  struct Powered_off : Simple_state<Powered_off> {};
+  struct Powered_on : Substate_machine<Powered_on> {
+    struct Stopped : Simple_state<Stopped> {};
+    struct Playing : Simple_state<Playing> {};
+
+    using Initial = Stopped;
+    using Transitions = Transition_table<
+      Transition<Stopped, Event::Play_pause_btn, Playing>,
+      Transition<Playing, Event::Play_pause_btn, Stopped>
+    >;
+
+    State_data_def<Transitions> state_data;
+  };
+
+  struct Set_volume {
+    template<typename SrcStateT>
+    void operator()(std::uint8_t& context, const SrcStateT&, const Event::Volume_set& evt)
+    {
+      context = evt.level;
+    }
+  };
+
+  using Initial = Powered_off;
+  using Transitions = Transition_table<
+    Transition<Powered_off, Event::Pwr_switch_flip, Powered_on>,
+    Transition<Powered_on, Event::Pwr_switch_flip, Powered_off>,
+    Transition<Powered_on, Event::Volume_set, Powered_on, Set_volume>
+  >;
+
+  State_data_def<Transitions> state_data;
+  std::uint8_t context;
+};
+
+using Player_log = uhsm::Event_log<Event::Pwr_switch_flip, Event::Play_pause_btn, Event::Volume_set>;
+
+struct Buffer_writer {
+  std::vector<std::byte>* buffer;
+
+  void operator()(const void* data, std::size_t size)
+  {
+    const auto bytes = static_cast<const std::byte*>(data);
+    buffer->insert(buffer->end(), bytes, bytes + size);
+  }
+};
+
+TEST_GROUP(EventLog_TestGroup)
+{
+};
+
+TEST(EventLog_TestGroup, Replay_RecordedStream_SameFinalConfiguration)
+{
+  std::vector<std::byte> buffer;
+  Player_log::Recorder<Buffer_writer> recorder{Buffer_writer{&buffer}};
+
+  Logged_player recorded_sm{};
+  recorded_sm.start();
+  recorder.react(recorded_sm, Event::Pwr_switch_flip{});  // enters 'Powered_on::Stopped'
+  recorder.react(recorded_sm, Event::Volume_set{7});
+  recorder.react(recorded_sm, Event::Play_pause_btn{});   // enters 'Powered_on::Playing'
+
+  Logged_player replayed_sm{};
+  replayed_sm.start();
+  Player_log::Reader<Logged_player> reader{buffer.data(), buffer.size()};
+
+  int event_count = 0;
+  while (reader.dispatch_next(replayed_sm)) {
+    ++event_count;
+  }
+
+  LONGS_EQUAL(3, event_count);
+  CHECK(reader.at_end());
+  CHECK(replayed_sm.is_in<Logged_player::Powered_on::Playing>());
+  LONGS_EQUAL(recorded_sm.current_leaf_id(), replayed_sm.current_leaf_id());
+  LONGS_EQUAL(7, replayed_sm.context);
+}
+
+TEST(EventLog_TestGroup, Replay_TruncatedStream_StopAtMalformedRecord)
+{
+  std::vector<std::byte> buffer;
+  Player_log::Recorder<Buffer_writer> recorder{Buffer_writer{&buffer}};
+  recorder.record(Event::Pwr_switch_flip{});
+  recorder.record(Event::Volume_set{7});
+  buffer.pop_back();
+
+  Logged_player sm{};
+  sm.start();
+  Player_log::Reader<Logged_player> reader{buffer.data(), buffer.size()};
+
+  CHECK(reader.dispatch_next(sm));
+  CHECK_FALSE(reader.dispatch_next(sm));
+  CHECK(reader.at_end());
+  CHECK(sm.is_in<Logged_player::Powered_on::Stopped>());
+}
+
+TEST(EventLog_TestGroup, Percentile_RecordedLatencies_ReturnBucketUpperBound)
+{
+  uhsm::Latency_histogram histogram;
+  for (std::uint64_t i = 1; i <= 100; ++i) {
+    histogram.record(i);
+  }
+
+  // NOTE: values of 16 and above share buckets with up to 1/8 relative width
+  const auto median = histogram.percentile(0.5);
+  CHECK(median >= 50 && median <= 55);
+  LONGS_EQUAL(100, histogram.total_count());
+  CHECK(histogram.percentile(1.0) >= 100);
+}
@@ -0,0 +1,235 @@
+#include <CppUTest/TestHarness.h>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include "uhsm/state_machine.h"
+
+namespace Event
+{
+  // an event with a large payload counting how many times it has been copied or moved
+  struct Large_payload {
+    static inline int copy_count = 0;
+    static inline int move_count = 0;
+
+    Large_payload() = default;
+    Large_payload(const Large_payload& other) : payload{other.payload} { ++copy_count; }
+    Large_payload(Large_payload&& other) : payload{other.payload} { ++move_count; }
+    Large_payload& operator=(const Large_payload&) = delete;
+    Large_payload& operator=(Large_payload&&) = delete;
+
+    std::array<std::byte, 64 * 1024> payload{};
+  };
+
+  struct Power_up {};
+  // an event which is not handled by any state
+  struct Unexpected {};
+}
+
+// an event observed by a hook which is not an event sink must be passed via const-reference
+template<typename EventT>
+constexpr bool is_observed_v = std::is_lvalue_reference_v<EventT> &&
+  std::is_const_v<std::remove_reference_t<EventT>>;
+
+namespace Action
+{
+  struct Observe_payload {
+    template<typename SrcStateT, typename EventT>
+    void operator()(const SrcStateT&, EventT&&)
+    {
+      static_assert(is_observed_v<EventT>, "Action of an external transition is not an event sink");
+    }
+  };
+
+  struct Take_payload {
+    template<typename SrcStateT, typename EventT>
+    void operator()(const SrcStateT&, EventT&& evt)
+    {
+      // NOTE: an action of an internal transition is an event sink; it takes ownership of the event
+      Event::Large_payload owned{std::forward<EventT>(evt)};
+    }
+  };
+}
+
+struct Observing_state {
+  template<typename EventT>
+  void on_entry(EventT&&)
+  {
+    static_assert(is_observed_v<EventT>, "Only the innermost entered state is an event sink");
+  }
+  template<typename EventT>
+  void on_exit(EventT&&)
+  {
+    static_assert(is_observed_v<EventT>, "on_exit is never an event sink");
+  }
+};
+
+struct Deep_machine : uhsm::State_machine<Deep_machine> {
+  struct Idle : Simple_state<Idle> {};
+
+  struct Level_1 : Substate_machine<Level_1>, Observing_state {
+    using Observing_state::on_entry;
+    using Observing_state::on_exit;
+
+    struct Level_2 : Substate_machine<Level_2>, Observing_state {
+      using Observing_state::on_entry;
+      using Observing_state::on_exit;
+
+      struct Leaf : Simple_state<Leaf> {
+        template<typename EventT>
+        void on_entry(EventT&& evt)
+        {
+          // NOTE: the innermost entered state is an event sink; it takes ownership of the event
+          Event::Large_payload owned{std::forward<EventT>(evt)};
+        }
+      };
+
+      using Initial = Leaf;
+      using Transitions = Transition_table<
+        Transition<Leaf, Event::Power_up, Leaf>
+      >;
+
+      State_data_def<Transitions> state_data;
+    };
+
+    using Initial = Level_2;
+    using Transitions = Transition_table<
+      Transition<Level_2, Event::Power_up, Level_2>
+    >;
+
+    State_data_def<Transitions> state_data;
+  };
+
+  using Initial = Idle;
+  using Transitions = Transition_table<
+    Transition<Idle, Event::Large_payload, Level_1, Action::Observe_payload>,
+    Transition<Level_1, Event::Large_payload, Level_1, Action::Take_payload>
+  >;
+
+  State_data_def<Transitions> state_data;
+};
+
+TEST_GROUP(EventPassing_TestGroup)
+{
+  void setup()
+  {
+    Event::Large_payload::copy_count = 0;
+    Event::Large_payload::move_count = 0;
+  }
+};
+
+TEST(EventPassing_TestGroup, React_DeepCascadeInTr_EventNeverCopied)
+{
+  Deep_machine sm;
+  sm.start();   // initialized with 'Idle'
+
+  sm.react(Event::Large_payload{});   // enters 'Level_1::Level_2::Leaf' which takes ownership of the event
+
+  LONGS_EQUAL(0, Event::Large_payload::copy_count);
+  LONGS_EQUAL(1, Event::Large_payload::move_count);
+}
+
+TEST(EventPassing_TestGroup, React_InternalTr_EventNeverCopied)
+{
+  Deep_machine sm;
+  sm.start();   // initialized with 'Idle'
+  sm.react(Event::Large_payload{});   // enters 'Level_1::Level_2::Leaf'
+
+  Event::Large_payload::move_count = 0;
+  sm.react(Event::Large_payload{});   // remains in 'Level_1', action takes ownership of the event
+
+  LONGS_EQUAL(0, Event::Large_payload::copy_count);
+  LONGS_EQUAL(1, Event::Large_payload::move_count);
+}
+
+TEST(EventPassing_TestGroup, React_ConstLvalueEvent_CopiedOnlyBySink)
+{
+  Deep_machine sm;
+  sm.start();   // initialized with 'Idle'
+
+  const Event::Large_payload evt{};
+  sm.react(evt);    // enters 'Level_1::Level_2::Leaf'
+
+  const bool in_state = uhsm::helpers::is_in_state<
+  Deep_machine,
+  Deep_machine::Level_1,
+  Deep_machine::Level_1::Level_2,
+  Deep_machine::Level_1::Level_2::Leaf>(sm);
+  CHECK(in_state);
+  // NOTE: a const event cannot be moved from; the only copy is made by 'Leaf' when it takes ownership
+  LONGS_EQUAL(1, Event::Large_payload::copy_count);
+  LONGS_EQUAL(0, Event::Large_payload::move_count);
+}
+
+// a machine whose destination state is constructed directly from the event triggering the transition
+struct Reassembly_machine : uhsm::State_machine<Reassembly_machine> {
+  struct Idle : Simple_state<Idle> {};
+
+  struct Assembling : Simple_state<Assembling>, Observing_state {
+    using Observing_state::on_entry;
+    using Observing_state::on_exit;
+
+    // NOTE: the state takes ownership of the event's payload; it is not default-constructible
+    explicit Assembling(Event::Large_payload&& evt) : first_fragment{std::move(evt)} {}
+    explicit Assembling(const Event::Large_payload& evt) : first_fragment{evt} {}
+
+    Event::Large_payload first_fragment;
+  };
+
+  using Initial = Idle;
+  using Transitions = Transition_table<
+    Transition<Idle, Event::Large_payload, Assembling, Action::Observe_payload>,
+    Transition<Assembling, Event::Power_up, Idle>
+  >;
+
+  State_data_def<Transitions> state_data;
+};
+
+TEST(EventPassing_TestGroup, React_DestStateConstructibleFromEvent_PayloadMovedIntoState)
+{
+  Reassembly_machine sm;
+  sm.start();   // initialized with 'Idle'
+
+  Event::Large_payload evt{};
+  evt.payload[0] = std::byte{0x5A};
+  sm.react(std::move(evt));   // 'Assembling' is constructed from the event
+
+  CHECK(sm.is_in<Reassembly_machine::Assembling>());
+  const auto& state = std::get<Reassembly_machine::Assembling>(sm.state_data);
+  CHECK(std::byte{0x5A} == state.first_fragment.payload[0]);
+  LONGS_EQUAL(0, Event::Large_payload::copy_count);
+  LONGS_EQUAL(1, Event::Large_payload::move_count);
+}
+
+TEST(EventPassing_TestGroup, React_DestStateConstructibleFromConstEvent_CopiedOnlyByState)
+{
+  Reassembly_machine sm;
+  sm.start();   // initialized with 'Idle'
+
+  const Event::Large_payload evt{};
+  sm.react(evt);
+
+  CHECK(sm.is_in<Reassembly_machine::Assembling>());
+  LONGS_EQUAL(1, Event::Large_payload::copy_count);
+  LONGS_EQUAL(0, Event::Large_payload::move_count);
+}
+
+TEST(EventPassing_TestGroup, React_VariantOfEvents_HeldEventPassedWithoutCopy)
+{
+  using Any_event = std::variant<Event::Power_up, Event::Large_payload, Event::Unexpected>;
+
+  Deep_machine sm;
+  sm.start();   // initialized with 'Idle'
+
+  Any_event evt{std::in_place_type<Event::Large_payload>};
+  const bool handled = sm.react(std::move(evt));   // enters 'Level_1::Level_2::Leaf' which takes ownership of the event
+
+  CHECK(handled);
+  CHECK(sm.is_in<Deep_machine::Level_1::Level_2::Leaf>());
+  LONGS_EQUAL(0, Event::Large_payload::copy_count);
+  LONGS_EQUAL(1, Event::Large_payload::move_count);
+
+  // NOTE: an alternative not handled by the state machine is ignored without any dispatch
+  CHECK_FALSE(sm.react(Any_event{Event::Unexpected{}}));
+}
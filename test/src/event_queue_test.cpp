@@ -0,0 +1,194 @@
+#include <CppUTest/TestHarness.h>
+#include <array>
+#include <cstdint>
+#include "uhsm/state_machine.h"
+#include "uhsm/event_queue.h"
+
+namespace Event
+{
+  struct Sample {
+    std::uint32_t value;
+  };
+  struct Fault {
+    static constexpr unsigned priority = 7;
+    std::uint32_t value;
+  };
+  struct Frame {
+    std::uint32_t value;
+    std::array<std::uint8_t, 60> payload;
+  };
+  // a latest-value event
+  struct Position {
+    static constexpr bool coalesce = true;
+    std::uint32_t value;
+  };
+  // an event which keeps track of its live objects
+  struct Tracked {
+    static inline int live_count = 0;
+
+    Tracked() { ++live_count; }
+    Tracked(const Tracked&) { ++live_count; }
+    Tracked(Tracked&&) { ++live_count; }
+    ~Tracked() { --live_count; }
+  };
+}
+
+// NOTE: values of processed events are kept in order of processing
+struct Processing_log {
+  std::uint32_t values[16];
+  int count;
+};
+
+struct Queue_consumer : uhsm::State_machine<Queue_consumer> {
+  struct Running : Simple_state<Running> {};
+
+  struct Log_value {
+    template<typename SrcStateT, typename EventT>
+    void operator()(Processing_log& context, const SrcStateT&, const EventT& evt)
+    {
+      context.values[context.count++] = evt.value;
+    }
+  };
+
+  using Initial = Running;
+  using Transitions = Transition_table<
+    Transition<Running, Event::Sample, Running, Log_value>,
+    Transition<Running, Event::Frame, Running, Log_value>,
+    Transition<Running, Event::Fault, Running, Log_value>,
+    Transition<Running, Event::Position, Running, Log_value>
+  >;
+
+  State_data_def<Transitions> state_data;
+  Processing_log context;
+};
+
+using Consumer_queue = uhsm::Event_queue<256, Event::Sample, Event::Frame, Event::Tracked>;
+
+TEST_GROUP(EventQueue_TestGroup)
+{
+};
+
+TEST(EventQueue_TestGroup, DispatchAll_MixedEvents_DispatchedInFifoOrder)
+{
+  Queue_consumer sm{};
+  sm.start();
+  Consumer_queue queue;
+
+  CHECK(queue.push(Event::Sample{1}));
+  CHECK(queue.push(Event::Frame{2, {}}));
+  CHECK(queue.push(Event::Sample{3}));
+
+  // NOTE: a small event occupies only its own size plus the header
+  LONGS_EQUAL(2 * Consumer_queue::record_size<Event::Sample> + Consumer_queue::record_size<Event::Frame>,
+    queue.used_bytes());
+  LONGS_EQUAL(3, queue.dispatch_all(sm));
+
+  CHECK(queue.empty());
+  LONGS_EQUAL(3, sm.context.count);
+  LONGS_EQUAL(1, sm.context.values[0]);
+  LONGS_EQUAL(2, sm.context.values[1]);
+  LONGS_EQUAL(3, sm.context.values[2]);
+}
+
+TEST(EventQueue_TestGroup, Push_ArenaFull_EventRejected)
+{
+  Consumer_queue queue;
+
+  // 256 bytes arena holds 3 frames (68 bytes each) but not a 4th one
+  CHECK(queue.push(Event::Frame{1, {}}));
+  CHECK(queue.push(Event::Frame{2, {}}));
+  CHECK(queue.push(Event::Frame{3, {}}));
+  CHECK_FALSE(queue.push(Event::Frame{4, {}}));
+  CHECK(queue.push(Event::Sample{5}));
+}
+
+TEST(EventQueue_TestGroup, Push_NoSpaceAtArenaEnd_WrapAroundInFifoOrder)
+{
+  Queue_consumer sm{};
+  sm.start();
+  Consumer_queue queue;
+
+  queue.push(Event::Frame{1, {}});
+  queue.push(Event::Frame{2, {}});
+  queue.push(Event::Frame{3, {}});
+  queue.dispatch_one(sm);
+  queue.dispatch_one(sm);
+
+  // NOTE: 52 bytes left at the end of the arena; the frame is placed at its beginning
+  CHECK(queue.push(Event::Frame{4, {}}));
+  CHECK(queue.push(Event::Sample{5}));
+  LONGS_EQUAL(3, queue.dispatch_all(sm));
+
+  CHECK(queue.empty());
+  LONGS_EQUAL(5, sm.context.count);
+  LONGS_EQUAL(3, sm.context.values[2]);
+  LONGS_EQUAL(4, sm.context.values[3]);
+  LONGS_EQUAL(5, sm.context.values[4]);
+}
+
+TEST(EventQueue_TestGroup, Destructor_QueuedEvents_EventsDestroyed)
+{
+  {
+    Consumer_queue queue;
+    queue.push(Event::Tracked{});
+    queue.push(Event::Tracked{});
+    LONGS_EQUAL(2, Event::Tracked::live_count);
+  }
+
+  LONGS_EQUAL(0, Event::Tracked::live_count);
+}
+
+TEST(EventQueue_TestGroup, DispatchOne_FaultQueuedAfterData_FaultDispatchedFirst)
+{
+  Queue_consumer sm{};
+  sm.start();
+  uhsm::Priority_event_queue<Queue_consumer, 256, Event::Sample, Event::Fault> queue{sm};
+
+  queue.push(Event::Sample{1});
+  queue.push(Event::Sample{2});
+  queue.push(Event::Fault{3});
+  queue.push(Event::Sample{4});
+
+  queue.dispatch_one();
+  LONGS_EQUAL(3, sm.context.values[0]);
+
+  // NOTE: events of the same priority are dispatched in order of arrival
+  LONGS_EQUAL(3, queue.dispatch_all());
+  CHECK(queue.empty());
+  LONGS_EQUAL(1, sm.context.values[1]);
+  LONGS_EQUAL(2, sm.context.values[2]);
+  LONGS_EQUAL(4, sm.context.values[3]);
+}
+
+TEST(EventQueue_TestGroup, Push_CoalescableEventPending_PendingEventReplaced)
+{
+  Queue_consumer sm{};
+  sm.start();
+  using Queue = uhsm::Event_queue<256, Event::Sample, Event::Position>;
+  Queue queue;
+
+  queue.push(Event::Sample{1});
+  queue.push(Event::Position{2});
+  queue.push(Event::Position{3});
+  queue.push(Event::Sample{4});
+  queue.push(Event::Position{5});
+  // NOTE: replacing a pending event takes no space
+  LONGS_EQUAL(2 * Queue::record_size<Event::Sample> + Queue::record_size<Event::Position>, queue.used_bytes());
+
+  // NOTE: the latest value is dispatched at the position of the first pending event
+  LONGS_EQUAL(3, queue.dispatch_all(sm));
+  LONGS_EQUAL(1, sm.context.values[0]);
+  LONGS_EQUAL(5, sm.context.values[1]);
+  LONGS_EQUAL(4, sm.context.values[2]);
+
+  // a dispatched event is not pending anymore
+  queue.push(Event::Position{6});
+  queue.dispatch_one(sm);
+  LONGS_EQUAL(0, queue.used_bytes());
+  // NOTE: the event is queued anew rather than assigned to the dispatched one
+  queue.push(Event::Position{7});
+  LONGS_EQUAL(Queue::record_size<Event::Position>, queue.used_bytes());
+  LONGS_EQUAL(1, queue.dispatch_all(sm));
+  LONGS_EQUAL(6, sm.context.values[3]);
+  LONGS_EQUAL(7, sm.context.values[4]);
+}
@@ -0,0 +1,81 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+#include <variant>
+#include "uhsm/state_machine.h"
+#include "mode_player.h"
+
+// NOTE: tests shared by all dispatch modes are in dispatch_mode_test.cpp
+
+using Flat_player = Mode_player<uhsm::Dispatch_mode::flat>;
+
+TEST_GROUP(FlatDispatch_TestGroup)
+{
+  void teardown()
+  {
+    mock().clear();
+  }
+};
+
+TEST(FlatDispatch_TestGroup, React_OuterLevelTr_ExitFromInnermostState)
+{
+  Flat_player sm;
+  sm.start();   // initialized with 'Powered_off'
+  mock().disable();
+  sm.react(Event::Pwr_switch_flip{});   // enters 'Powered_on::Stopped'
+  sm.react(Event::Play_pause_btn{});    // enters 'Powered_on::Active::Playing'
+  mock().enable();
+
+  mock().strictOrder();
+  mock().expectOneCall("playing_EXIT");
+  mock().expectOneCall("active_EXIT");
+  mock().expectOneCall("stopped_ENTRY");
+
+  // NOTE: handled by the transition table of 'Powered_on' with a single lookup
+  const bool handled = sm.react(Event::Stop_btn{});   // enters 'Powered_on::Stopped'
+
+  mock().checkExpectations();
+  CHECK(handled);
+  CHECK(sm.is_in<Flat_player::Powered_on::Stopped>());
+}
+
+TEST(FlatDispatch_TestGroup, React_CrossLevelTr_ExitUpToLca)
+{
+  Flat_player sm;
+  sm.start();   // initialized with 'Powered_off'
+  mock().disable();
+  sm.react(Event::Pwr_switch_flip{});   // enters 'Powered_on::Stopped'
+  sm.react(Event::Play_pause_btn{});    // enters 'Powered_on::Active::Playing'
+  mock().enable();
+
+  mock().strictOrder();
+  mock().expectOneCall("playing_EXIT");
+  mock().expectOneCall("active_EXIT");
+  mock().expectOneCall("powered_on_EXIT");
+
+  const bool handled = sm.react(Event::Eject_btn{});    // enters 'Powered_off'
+
+  mock().checkExpectations();
+  CHECK(handled);
+  CHECK(sm.is_in<Flat_player::Powered_off>());
+}
+
+TEST(FlatDispatch_TestGroup, React_VariantOfEvents_SingleLookupPerEvent)
+{
+  using Any_event = std::variant<Event::Pwr_switch_flip, Event::Play_pause_btn, Event::Eject_btn>;
+
+  Flat_player sm;
+  sm.start();   // initialized with 'Powered_off'
+
+  mock().strictOrder();
+  mock().expectOneCall("turn_led_on");
+  mock().expectOneCall("powered_off_EXIT");
+  mock().expectOneCall("powered_on_ENTRY");
+  mock().expectOneCall("stopped_ENTRY");
+
+  const Any_event flip{Event::Pwr_switch_flip{}};
+  CHECK(sm.react(flip));      // enters 'Powered_on::Stopped'
+  CHECK_FALSE(sm.react(Any_event{Event::Eject_btn{}}));
+
+  mock().checkExpectations();
+  CHECK(sm.is_in<Flat_player::Powered_on::Stopped>());
+}
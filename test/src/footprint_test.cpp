@@ -0,0 +1,73 @@
+#include <CppUTest/TestHarness.h>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include "uhsm/state_machine.h"
+#include "uhsm/footprint.h"
+
+namespace Event
+{
+  struct Toggle {};
+}
+
+struct Packet_machine : uhsm::State_machine<Packet_machine> {
+  static constexpr std::size_t storage_budget = 128;
+
+  struct Idle : Simple_state<Idle> {};
+
+  struct Receiving : Substate_machine<Receiving> {
+    struct Header : Simple_state<Header> {
+      std::uint32_t fields[4];
+    };
+    struct Body : Simple_state<Body> {
+      std::uint8_t buffer[64];
+    };
+
+    using Initial = Header;
+    using Transitions = Transition_table<
+      Transition<Header, Event::Toggle, Body>,
+      Transition<Body, Event::Toggle, Header>
+    >;
+
+    State_data_def<Transitions> state_data;
+  };
+
+  using Initial = Idle;
+  using Transitions = Transition_table<
+    Transition<Idle, Event::Toggle, Receiving>,
+    Transition<Receiving, Event::Toggle, Idle>
+  >;
+
+  State_data_def<Transitions> state_data;
+};
+
+using Packet_footprint = uhsm::Footprint_report<Packet_machine>;
+
+namespace Test::FootprintReport_NestedLargeState_LargestPathLeadsToIt
+{
+  static_assert(std::is_same_v<Packet_footprint::Largest_path,
+    std::tuple<Packet_machine, Packet_machine::Receiving, Packet_machine::Receiving::Body>>);
+  static_assert(Packet_footprint::root.size == sizeof(Packet_machine));
+  static_assert(Packet_footprint::root.largest_nested_size == sizeof(Packet_machine::Receiving));
+  static_assert(uhsm::helpers::within_storage_budget<Packet_machine>::value);
+}
+
+TEST_GROUP(Footprint_TestGroup)
+{
+};
+
+TEST(Footprint_TestGroup, FootprintReport_StatesIndexedById_FootprintsMatchStates)
+{
+  using uhsm::helpers::state_id_v;
+  constexpr auto receiving_id = state_id_v<Packet_machine, Packet_machine::Receiving>;
+  constexpr auto body_id = state_id_v<Packet_machine, Packet_machine::Receiving::Body>;
+
+  LONGS_EQUAL(sizeof(Packet_machine::Receiving), Packet_footprint::states[receiving_id].size);
+  LONGS_EQUAL(sizeof(Packet_machine::Receiving::state_data), Packet_footprint::states[receiving_id].state_data_size);
+  LONGS_EQUAL(64, Packet_footprint::states[body_id].size);
+  LONGS_EQUAL(0, Packet_footprint::states[body_id].state_data_size);
+
+  LONGS_EQUAL(2, Packet_footprint::largest_path_ids.size());
+  LONGS_EQUAL(receiving_id, Packet_footprint::largest_path_ids[0]);
+  LONGS_EQUAL(body_id, Packet_footprint::largest_path_ids[1]);
+}
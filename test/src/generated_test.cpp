@@ -0,0 +1,53 @@
+#include <CppUTest/TestHarness.h>
+#include <type_traits>
+#include "gen_player.h"
+
+// NOTE: the machine is generated at build time from test/gen/gen_player.uhsm
+
+using Gen::Gen_player;
+
+namespace Test::GeneratedStateList_TransitionTable_MatchesExtractedStateSet
+{
+  using uhsm::helpers::extract_state_set_t;
+
+  static_assert(std::is_same_v<Gen_player::State_list, extract_state_set_t<Gen_player::Transitions>>);
+  static_assert(std::is_same_v<Gen_player::Powered_on::State_list,
+    extract_state_set_t<Gen_player::Powered_on::Transitions>>);
+  static_assert(uhsm::helpers::state_id_v<Gen_player, Gen_player::Powered_on::Active::Paused> == 4);
+  static_assert(uhsm::helpers::state_id_v<Gen_player, Gen_player::Powered_on::Stopped> == 5);
+}
+
+TEST_GROUP(Generated_TestGroup)
+{
+  Gen_player sm{};
+
+  void setup()
+  {
+    sm.start();
+  }
+};
+
+TEST(Generated_TestGroup, React_NestedTransitions_ConfigurationChanged)
+{
+  sm.react(Gen::Pwr_switch_flip{});
+  CHECK(sm.is_in<Gen_player::Powered_on::Stopped>());
+
+  sm.react(Gen::Play_pause_btn{});
+  sm.react(Gen::Play_pause_btn{});
+  CHECK(sm.is_in<Gen_player::Powered_on::Active::Paused>());
+
+  sm.react(Gen::Stop_btn{});
+  CHECK(sm.is_in<Gen_player::Powered_on::Stopped>());
+}
+
+TEST(Generated_TestGroup, React_HooksAndActionsOfDescription_Invoked)
+{
+  sm.react(Gen::Pwr_switch_flip{});
+  CHECK(sm.context.led_on);
+
+  sm.react(Gen::Play_pause_btn{});
+  LONGS_EQUAL(1, sm.context.start_count);
+
+  sm.react(Gen::Pwr_switch_flip{});
+  CHECK_FALSE(sm.context.led_on);
+}
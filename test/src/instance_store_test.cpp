@@ -0,0 +1,95 @@
+#include <CppUTest/TestHarness.h>
+#include <cstdint>
+#include "uhsm/state_machine.h"
+#include "uhsm/instance_store.h"
+
+namespace Event
+{
+  struct Ping {};
+}
+
+struct Session : uhsm::State_machine<Session> {
+  struct Idle : Simple_state<Idle> {};
+  struct Busy : Simple_state<Busy> {};
+
+  using Initial = Idle;
+  using Transitions = Transition_table<
+    Transition<Idle, Event::Ping, Busy>,
+    Transition<Busy, Event::Ping, Idle>
+  >;
+
+  State_data_def<Transitions> state_data;
+};
+
+TEST_GROUP(InstanceStore_TestGroup)
+{
+};
+
+TEST(InstanceStore_TestGroup, Emplace_IdAlreadyPresent_Rejected)
+{
+  uhsm::Instance_store<Session> store{100};
+
+  CHECK(store.emplace(42) != nullptr);
+  POINTERS_EQUAL(nullptr, store.emplace(42));
+  LONGS_EQUAL(1, store.size());
+  CHECK(store.find(42)->is_in<Session::Idle>());
+  POINTERS_EQUAL(nullptr, store.find(43));
+}
+
+TEST(InstanceStore_TestGroup, React_IdPassed_OnlyAddressedInstanceReacts)
+{
+  uhsm::Instance_store<Session> store{100};
+  const std::uint64_t ids[] = {1, 2, 3};
+  LONGS_EQUAL(3, store.insert_bulk(ids, 3));
+
+  CHECK(store.react(2, Event::Ping{}));
+  CHECK_FALSE(store.react(4, Event::Ping{}));
+
+  CHECK(store.find(1)->is_in<Session::Idle>());
+  CHECK(store.find(2)->is_in<Session::Busy>());
+  CHECK(store.find(3)->is_in<Session::Idle>());
+}
+
+TEST(InstanceStore_TestGroup, Erase_StoreFilledToCapacity_RemainingInstancesKeptIntact)
+{
+  // NOTE: 16 slots for 14 instances; probe sequences of the instances overlap
+  uhsm::Instance_store<Session> store{14};
+  for (std::uint64_t id = 0; id < 14; ++id) {
+    store.emplace(id * 1000);
+    store.react(id * 1000, Event::Ping{});
+  }
+  POINTERS_EQUAL(nullptr, store.emplace(14000));
+
+  for (std::uint64_t id = 0; id < 14; id += 2) {
+    CHECK(store.erase(id * 1000));
+  }
+  CHECK_FALSE(store.erase(0));
+
+  LONGS_EQUAL(7, store.size());
+  for (std::uint64_t id = 0; id < 14; ++id) {
+    auto* sm = store.find(id * 1000);
+    CHECK_EQUAL(id % 2 != 0, sm != nullptr);
+    // NOTE: instances moved back within probe sequences keep their configuration
+    CHECK(sm == nullptr || sm->is_in<Session::Busy>());
+  }
+}
+
+TEST(InstanceStore_TestGroup, FindBatch_BurstOfIds_EachIdResolved)
+{
+  uhsm::Instance_store<Session> store{1000};
+  std::uint64_t ids[40];
+  Session* found[40];
+
+  for (std::uint64_t i = 0; i < 40; ++i) {
+    ids[i] = i * 7919;
+    if (i % 3 != 0) {
+      store.emplace(ids[i]);
+    }
+  }
+
+  store.find_batch(ids, 40, found);
+
+  for (std::uint64_t i = 0; i < 40; ++i) {
+    POINTERS_EQUAL(i % 3 != 0 ? store.find(ids[i]) : nullptr, found[i]);
+  }
+}
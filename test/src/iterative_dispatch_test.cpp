@@ -0,0 +1,229 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+#include <variant>
+#include "uhsm/state_machine.h"
+#include "mode_player.h"
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#endif
+
+// NOTE: tests shared by all dispatch modes are in dispatch_mode_test.cpp
+
+namespace Event
+{
+  struct Probe_enter {};
+  struct Probe_jump {};
+}
+
+using Iterative_player = Mode_player<uhsm::Dispatch_mode::iterative>;
+
+TEST_GROUP(IterativeDispatch_TestGroup)
+{
+  void teardown()
+  {
+    mock().clear();
+  }
+};
+
+TEST(IterativeDispatch_TestGroup, React_OuterLevelTr_ExitFromInnermostState)
+{
+  Iterative_player sm;
+  sm.start();   // initialized with 'Powered_off'
+  mock().disable();
+  sm.react(Event::Pwr_switch_flip{});   // enters 'Powered_on::Stopped'
+  sm.react(Event::Play_pause_btn{});    // enters 'Powered_on::Active::Playing'
+  mock().enable();
+
+  mock().strictOrder();
+  mock().expectOneCall("playing_EXIT");
+  mock().expectOneCall("active_EXIT");
+  mock().expectOneCall("stopped_ENTRY");
+
+  // NOTE: found by walking the active path up to the transition table of 'Powered_on'
+  const bool handled = sm.react(Event::Stop_btn{});   // enters 'Powered_on::Stopped'
+
+  mock().checkExpectations();
+  CHECK(handled);
+  CHECK(sm.is_in<Iterative_player::Powered_on::Stopped>());
+}
+
+TEST(IterativeDispatch_TestGroup, React_CrossLevelTr_ExitUpToLca)
+{
+  Iterative_player sm;
+  sm.start();   // initialized with 'Powered_off'
+  mock().disable();
+  sm.react(Event::Pwr_switch_flip{});   // enters 'Powered_on::Stopped'
+  sm.react(Event::Play_pause_btn{});    // enters 'Powered_on::Active::Playing'
+  mock().enable();
+
+  mock().strictOrder();
+  mock().expectOneCall("playing_EXIT");
+  mock().expectOneCall("active_EXIT");
+  mock().expectOneCall("powered_on_EXIT");
+
+  const bool handled = sm.react(Event::Eject_btn{});    // enters 'Powered_off'
+
+  mock().checkExpectations();
+  CHECK(handled);
+  CHECK(sm.is_in<Iterative_player::Powered_off>());
+}
+
+TEST(IterativeDispatch_TestGroup, React_VariantOfEvents_SingleLookupPerLevel)
+{
+  using Any_event = std::variant<Event::Pwr_switch_flip, Event::Play_pause_btn, Event::Eject_btn>;
+
+  Iterative_player sm;
+  sm.start();   // initialized with 'Powered_off'
+  mock().disable();
+  sm.react(Any_event{Event::Pwr_switch_flip{}});    // enters 'Powered_on::Stopped'
+  mock().enable();
+
+  mock().strictOrder();
+  mock().expectOneCall("stopped_EXIT");
+  mock().expectOneCall("active_ENTRY");
+  mock().expectOneCall("playing_ENTRY");
+  mock().expectOneCall("playing_EXIT");
+  mock().expectOneCall("active_EXIT");
+  mock().expectOneCall("powered_on_EXIT");
+
+  // NOTE: the row of the held alternative is looked up by each state on the active path
+  const Any_event play_pause{Event::Play_pause_btn{}};
+  CHECK(sm.react(play_pause));    // enters 'Powered_on::Active::Playing'
+  CHECK(sm.react(Any_event{Event::Eject_btn{}}));   // cross-level transition, enters 'Powered_off'
+  CHECK_FALSE(sm.react(Any_event{Event::Eject_btn{}}));
+
+  mock().checkExpectations();
+  CHECK(sm.is_in<Iterative_player::Powered_off>());
+}
+
+TEST(IterativeDispatch_TestGroup, React_CrossLevelTrIntoNestedState_EnterPathFromLca)
+{
+  Iterative_player sm;
+  sm.start();   // initialized with 'Powered_off'
+
+  mock().strictOrder();
+  mock().expectOneCall("powered_off_EXIT");
+  mock().expectOneCall("powered_on_ENTRY");
+  mock().expectOneCall("active_ENTRY");
+  mock().expectOneCall("playing_ENTRY");
+
+  const bool handled = sm.react(Event::Backward_btn{});   // enters 'Powered_on::Active::Playing'
+
+  mock().checkExpectations();
+  CHECK(handled);
+  CHECK(sm.is_in<Iterative_player::Powered_on::Active::Playing>());
+}
+
+// NOTE: 'Powered_on::Active::Playing' is the deepest state
+static_assert(uhsm::helpers::max_nesting_depth_v<Iterative_player> == 3);
+
+#if __has_include(<execinfo.h>)
+
+// gives the number of frames on the call stack of the calling function (its own frame included)
+__attribute__((noinline)) static std::size_t stack_frame_count()
+{
+  void* frames[256];
+  return static_cast<std::size_t>(backtrace(frames, 256)) - 1;
+}
+
+// a state machine whose deepest initial state records the stack depth at which its on_entry is invoked
+struct Depth_probe : uhsm::State_machine<Depth_probe> {
+  static constexpr auto dispatch_mode = uhsm::Dispatch_mode::iterative;
+
+  struct Idle : Simple_state<Idle> {};
+  struct Busy : Substate_machine<Busy> {
+    struct Outer : Substate_machine<Outer> {
+      struct Inner : Simple_state<Inner> {
+        template<typename EventT>
+        void on_entry(std::size_t& context, EventT&&) { context = stack_frame_count(); }
+      };
+
+      using Initial = Inner;
+      using Transitions = Transition_table<
+        Transition<Inner, Event::Probe_enter, Inner>
+      >;
+
+      State_data_def<Transitions> state_data;
+    };
+
+    using Initial = Outer;
+    using Transitions = Transition_table<
+      Transition<Outer, Event::Probe_enter, Outer>
+    >;
+
+    State_data_def<Transitions> state_data;
+  };
+
+  using Initial = Idle;
+  using Transitions = Transition_table<
+    Transition<Idle, Event::Probe_enter, Busy>,
+    Transition<Busy, Event::Probe_jump, Idle>
+  >;
+  using Cross_transitions = Transition_table<
+    Transition<Idle, Event::Probe_jump, Busy::Outer>
+  >;
+
+  State_data_def<Transitions> state_data;
+  std::size_t context;
+};
+
+TEST_GROUP(IterativeDispatchCallDepth_TestGroup)
+{
+  Depth_probe sm{};
+
+  void setup()
+  {
+    sm.start();
+  }
+
+  // checks the number of the library's frames between `react()` and a hook against the documented chain
+  void check_library_frames(std::size_t base_frame_count, std::size_t expected)
+  {
+    const std::size_t library_frames = sm.context - base_frame_count - 1;
+
+#ifdef __OPTIMIZE__
+    // NOTE: calls of the chain may be inlined
+    CHECK(library_frames <= expected);
+#else
+    CHECK_EQUAL(expected, library_frames);
+#endif
+  }
+};
+
+TEST(IterativeDispatchCallDepth_TestGroup, React_TrEntersInitialStates_CallDepthMatchesLongestChain)
+{
+  const std::size_t base_frame_count = stack_frame_count();
+  sm.react(Event::Probe_enter{});   // enters 'Busy::Outer::Inner'
+
+  check_library_frames(base_frame_count, uhsm::helpers::iterative_event_call_depth);
+}
+
+TEST(IterativeDispatchCallDepth_TestGroup, React_CrossLevelTrEntersInitialStates_CallDepthMatchesLongestChain)
+{
+  const std::size_t base_frame_count = stack_frame_count();
+  sm.react(Event::Probe_jump{});    // enters 'Busy::Outer::Inner'
+
+  check_library_frames(base_frame_count, uhsm::helpers::iterative_event_call_depth);
+}
+
+TEST(IterativeDispatchCallDepth_TestGroup, React_VariantOfEventsPassed_CallDepthIncludesVariantLayer)
+{
+  std::variant<Event::Probe_enter, Event::Probe_jump> evt{Event::Probe_enter{}};
+
+  const std::size_t base_frame_count = stack_frame_count();
+  sm.react(evt);    // enters 'Busy::Outer::Inner'
+
+  check_library_frames(base_frame_count, uhsm::helpers::iterative_dispatch_call_depth);
+}
+
+TEST(IterativeDispatchCallDepth_TestGroup, React_VariantOfEventsTakesCrossLevelTr_CallDepthIncludesVariantLayer)
+{
+  std::variant<Event::Probe_enter, Event::Probe_jump> evt{Event::Probe_jump{}};
+
+  const std::size_t base_frame_count = stack_frame_count();
+  sm.react(evt);    // enters 'Busy::Outer::Inner'
+
+  check_library_frames(base_frame_count, uhsm::helpers::iterative_dispatch_call_depth);
+}
+
+#endif
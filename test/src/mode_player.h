@@ -0,0 +1,121 @@
+#ifndef UHSM_TEST_MODE_PLAYER_H_
+#define UHSM_TEST_MODE_PLAYER_H_
+
+#include <CppUTestExt/MockSupport.h>
+#include "uhsm/state_machine.h"
+
+// NOTE: a player state machine shared by tests of the dispatch modes; hooks and actions are reported
+// to the mock, so the same expectations hold for each mode
+
+namespace Event
+{
+  struct Pwr_switch_flip {};
+  struct Play_pause_btn {};
+  struct Stop_btn {};
+  struct Forward_btn {};
+  struct Backward_btn {};
+  struct Eject_btn {};
+}
+
+namespace Action
+{
+  struct Mode_turn_led_on {
+    template<typename SrcStateT, typename EventT>
+    void operator()(const SrcStateT&, EventT&&)
+    {
+      mock().actualCall("turn_led_on");
+    }
+  };
+
+  struct Mode_playback_pos_forward {
+    template<typename SrcStateT, typename EventT>
+    void operator()(const SrcStateT&, EventT&&)
+    {
+      mock().actualCall("playback_pos_forward");
+    }
+  };
+}
+
+template<uhsm::Dispatch_mode ModeV>
+struct Mode_player : uhsm::State_machine<Mode_player<ModeV>> {
+  static constexpr auto dispatch_mode = ModeV;
+
+  // NOTE: names of the (dependent) base are brought in for nested states
+  using Base = uhsm::State_machine<Mode_player>;
+  template<typename U>
+  using Simple_state = typename Base::template Simple_state<U>;
+  template<typename U>
+  using Substate_machine = typename Base::template Substate_machine<U>;
+  template<typename SrcStateT, typename EventT, typename DestStateT, typename ActionT = uhsm::Empty_action>
+  using Transition = typename Base::template Transition<SrcStateT, EventT, DestStateT, ActionT>;
+  template<typename... TransitionTs>
+  using Transition_table = typename Base::template Transition_table<TransitionTs...>;
+  template<typename TransitionTableT>
+  using State_data_def = typename Base::template State_data_def<TransitionTableT>;
+
+  struct Powered_off : Simple_state<Powered_off> {
+    template<typename EventT>
+    void on_exit(EventT&&) { mock().actualCall("powered_off_EXIT"); }
+  };
+
+  struct Powered_on : Substate_machine<Powered_on> {
+    template<typename EventT>
+    void on_entry(EventT&&) { mock().actualCall("powered_on_ENTRY"); }
+    template<typename EventT>
+    void on_exit(EventT&&) { mock().actualCall("powered_on_EXIT"); }
+
+    struct Stopped : Simple_state<Stopped> {
+      template<typename EventT>
+      void on_entry(EventT&&) { mock().actualCall("stopped_ENTRY"); }
+      template<typename EventT>
+      void on_exit(EventT&&) { mock().actualCall("stopped_EXIT"); }
+    };
+
+    struct Active : Substate_machine<Active> {
+      template<typename EventT>
+      void on_entry(EventT&&) { mock().actualCall("active_ENTRY"); }
+      template<typename EventT>
+      void on_exit(EventT&&) { mock().actualCall("active_EXIT"); }
+
+      struct Playing : Simple_state<Playing> {
+        template<typename EventT>
+        void on_entry(EventT&&) { mock().actualCall("playing_ENTRY"); }
+        template<typename EventT>
+        void on_exit(EventT&&) { mock().actualCall("playing_EXIT"); }
+      };
+      struct Paused : Simple_state<Paused> {};
+
+      using Initial = Playing;
+      using Transitions = Transition_table<
+        Transition<Playing, Event::Play_pause_btn, Paused>,
+        Transition<Paused, Event::Play_pause_btn, Playing>
+      >;
+
+      State_data_def<Transitions> state_data;
+    };
+
+    using Initial = Stopped;
+    using Transitions = Transition_table<
+      Transition<Stopped, Event::Play_pause_btn, Active>,
+      Transition<Active, Event::Stop_btn, Stopped>,
+      Transition<Active, Event::Forward_btn, Active, Action::Mode_playback_pos_forward>,
+      Transition<Active, Event::Backward_btn, Active>
+    >;
+
+    State_data_def<Transitions> state_data;
+  };
+
+  using Initial = Powered_off;
+  using Transitions = Transition_table<
+    Transition<Powered_off, Event::Pwr_switch_flip, Powered_on, Action::Mode_turn_led_on>,
+    Transition<Powered_on, Event::Pwr_switch_flip, Powered_off>
+  >;
+  using Cross_transitions = Transition_table<
+    Transition<typename Powered_on::Active::Playing, Event::Eject_btn, Powered_off>,
+    Transition<Powered_off, Event::Backward_btn, typename Powered_on::Active>
+  >;
+
+  State_data_def<Transitions> state_data;
+};
+
+#endif
@@ -0,0 +1,149 @@
+#include <CppUTest/TestHarness.h>
+#include <cstdint>
+#include "uhsm/state_machine.h"
+#include "uhsm/profiler.h"
+
+namespace Event
+{
+  struct Dial {};
+  struct Hang_up {};
+}
+
+// a clock advancing by 10 ticks on each reading
+struct Fake_ticks {
+  static inline std::uint64_t ticks = 0;
+
+  static std::uint64_t now()
+  {
+    return ticks += 10;
+  }
+};
+
+namespace Action
+{
+  struct Open_line {
+    template<typename SrcStateT, typename EventT>
+    void operator()(const SrcStateT&, const EventT&) {}
+  };
+
+  struct Reset_line {
+    template<typename SrcStateT, typename EventT>
+    void operator()(const SrcStateT&, const EventT&) {}
+  };
+}
+
+struct Profiled_phone : uhsm::State_machine<Profiled_phone> {
+  struct On_hook : Simple_state<On_hook> {
+    template<typename EventT>
+    void on_exit(EventT&&) {}
+  };
+
+  struct Off_hook : Substate_machine<Off_hook> {
+    template<typename EventT>
+    void on_entry(EventT&&) {}
+
+    struct Dialing : Simple_state<Dialing> {};
+
+    using Initial = Dialing;
+    using Transitions = Transition_table<
+      Transition<Dialing, Event::Dial, Dialing>
+    >;
+
+    State_data_def<Transitions> state_data;
+  };
+
+  using Initial = On_hook;
+  using Transitions = Transition_table<
+    Transition<On_hook, Event::Dial, Off_hook, Action::Open_line>,
+    Transition<On_hook, Event::Hang_up, On_hook, Action::Reset_line>,
+    Transition<Off_hook, Event::Hang_up, On_hook>
+  >;
+
+  State_data_def<Transitions> state_data;
+  uhsm::Profiler<Profiled_phone, Fake_ticks> profiler;
+};
+
+TEST_GROUP(Profiler_TestGroup)
+{
+  uhsm::Profile<Profiled_phone> profile;
+};
+
+TEST(Profiler_TestGroup, React_ProfileAttached_EachDeclaredHookRecordedForItsState)
+{
+  Profiled_phone sm;
+  sm.start();
+  sm.profiler.attach(&profile);
+
+  sm.react(Event::Dial{});   // exits 'On_hook', enters 'Off_hook' and 'Dialing'
+
+  using uhsm::Profiled_hook;
+  LONGS_EQUAL(1, profile.histogram<Profiled_phone::On_hook>(Profiled_hook::exit).total_count());
+  LONGS_EQUAL(1, (profile.action_histogram<Profiled_phone::On_hook, Event::Dial>().total_count()));
+  LONGS_EQUAL(1, profile.histogram<Profiled_phone::Off_hook>(Profiled_hook::entry).total_count());
+  // NOTE: default hooks are not invoked, hence not measured
+  LONGS_EQUAL(0, profile.histogram<Profiled_phone::Off_hook::Dialing>(Profiled_hook::entry).total_count());
+  LONGS_EQUAL(0, profile.histogram<Profiled_phone::Off_hook::Dialing>(Profiled_hook::exit).total_count());
+  LONGS_EQUAL(1, profile.histogram(Profiled_hook::react, 0).total_count());
+  // NOTE: each hook is measured by two consecutive clock readings
+  LONGS_EQUAL(10, profile.histogram<Profiled_phone::Off_hook>(Profiled_hook::entry).percentile(1.0));
+}
+
+TEST(Profiler_TestGroup, React_ProfileDetached_NothingRecorded)
+{
+  Profiled_phone sm;
+  sm.start();
+  sm.profiler.attach(&profile);
+  sm.react(Event::Dial{});
+
+  sm.profiler.detach();
+  sm.react(Event::Hang_up{});
+
+  uhsm::Profile<Profiled_phone> merged;
+  merged.merge(profile);
+  merged.merge(profile);
+  LONGS_EQUAL(2, merged.histogram(uhsm::Profiled_hook::react, 0).total_count());
+  LONGS_EQUAL(0, merged.histogram<Profiled_phone::Off_hook>(uhsm::Profiled_hook::exit).total_count());
+}
+
+TEST(Profiler_TestGroup, React_TrsFromSameState_ActionsRecordedPerTr)
+{
+  Profiled_phone sm;
+  sm.start();
+  sm.profiler.attach(&profile);
+
+  sm.react(Event::Hang_up{});   // remains in 'On_hook', invokes 'Reset_line'
+  sm.react(Event::Hang_up{});   // remains in 'On_hook', invokes 'Reset_line'
+  sm.react(Event::Dial{});      // enters 'Off_hook', invokes 'Open_line'
+
+  LONGS_EQUAL(2, (profile.action_histogram<Profiled_phone::On_hook, Event::Hang_up>().total_count()));
+  LONGS_EQUAL(1, (profile.action_histogram<Profiled_phone::On_hook, Event::Dial>().total_count()));
+
+  using Reset_line_tr = Profiled_phone::Transition<Profiled_phone::On_hook, Event::Hang_up,
+    Profiled_phone::On_hook, Action::Reset_line>;
+  constexpr auto reset_line_id = uhsm::helpers::transition_id_v<Profiled_phone, Reset_line_tr>;
+  LONGS_EQUAL(2, profile.histogram(uhsm::Profiled_hook::action, reset_line_id).total_count());
+}
+
+TEST(Profiler_TestGroup, Take_ProfilesPublished_LatestPublishedProfileTaken)
+{
+  static uhsm::Profile_exchange<Profiled_phone> exchange;
+  Profiled_phone sm;
+  sm.start();
+  sm.profiler.attach(&profile);
+
+  LONGS_EQUAL(0, exchange.take().histogram(uhsm::Profiled_hook::react, 0).total_count());
+
+  sm.react(Event::Dial{});
+  exchange.publish(profile);
+  sm.react(Event::Hang_up{});
+  exchange.publish(profile);
+
+  // NOTE: the recording thread keeps recording into its own profile
+  sm.react(Event::Dial{});
+
+  uhsm::Profile<Profiled_phone> exported;
+  exported.merge(exchange.take());
+  LONGS_EQUAL(2, exported.histogram(uhsm::Profiled_hook::react, 0).total_count());
+  // NOTE: nothing has been published since
+  LONGS_EQUAL(2, exchange.take().histogram(uhsm::Profiled_hook::react, 0).total_count());
+}
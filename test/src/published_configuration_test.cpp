@@ -0,0 +1,80 @@
+#include <CppUTest/TestHarness.h>
+#include <array>
+#include "uhsm/state_machine.h"
+#include "uhsm/published_configuration.h"
+
+namespace Event
+{
+  struct Arm {};
+  struct Trip {};
+  struct Reset {};
+}
+
+struct Published_alarm : uhsm::State_machine<Published_alarm> {
+  struct Disarmed : Simple_state<Disarmed> {};
+
+  struct Armed : Substate_machine<Armed> {
+    struct Watching : Simple_state<Watching> {};
+    struct Ringing : Simple_state<Ringing> {};
+
+    using Initial = Watching;
+    using Transitions = Transition_table<
+      Transition<Watching, Event::Trip, Ringing>,
+      Transition<Ringing, Event::Trip, Ringing>
+    >;
+
+    State_data_def<Transitions> state_data;
+  };
+
+  using Initial = Disarmed;
+  using Transitions = Transition_table<
+    Transition<Disarmed, Event::Arm, Armed>,
+    Transition<Armed, Event::Reset, Disarmed>
+  >;
+
+  State_data_def<Transitions> state_data;
+  uhsm::Published_configuration<Published_alarm> published_configuration;
+};
+
+TEST_GROUP(PublishedConfiguration_TestGroup)
+{
+};
+
+TEST(PublishedConfiguration_TestGroup, Snapshot_StateChanged_LatestConfigurationPublished)
+{
+  Published_alarm sm;
+  CHECK_FALSE(sm.published_configuration.published());
+
+  sm.start();
+  auto snapshot = sm.published_configuration.snapshot();
+  CHECK(snapshot.is_in<Published_alarm::Disarmed>());
+  LONGS_EQUAL(0, snapshot.version());
+
+  sm.react(Event::Arm{});
+  sm.react(Event::Trip{});
+  snapshot = sm.published_configuration.snapshot();
+  CHECK(snapshot.is_in<Published_alarm::Armed>());
+  CHECK(snapshot.is_in<Published_alarm::Armed::Ringing>());
+  LONGS_EQUAL(sm.current_leaf_id(), snapshot.leaf_id());
+  LONGS_EQUAL(2, snapshot.version());
+
+  // NOTE: an internal transition does not change the configuration, so nothing is published
+  sm.react(Event::Trip{});
+  LONGS_EQUAL(2, sm.published_configuration.snapshot().version());
+}
+
+TEST(PublishedConfiguration_TestGroup, StateIds_NestedStateCurrent_ReturnIdsFromOutermostLevel)
+{
+  using uhsm::helpers::state_id_v;
+
+  Published_alarm sm;
+  sm.start();
+  sm.react(Event::Arm{});
+
+  std::array<uhsm::helpers::State_id, 2> ids{};
+  const auto depth = sm.published_configuration.snapshot().state_ids(ids);
+
+  LONGS_EQUAL(2, depth);
+  LONGS_EQUAL((state_id_v<Published_alarm, Published_alarm::Armed>), ids[0]);
+  LONGS_EQUAL((state_id_v<Published_alarm, Published_alarm::Armed::Watching>), ids[1]);
+}
@@ -0,0 +1,193 @@
+#include <CppUTest/TestHarness.h>
+#include <cstring>
+#include <string>
+#include "uhsm/state_machine.h"
+#include "uhsm/runtime_machine.h"
+
+namespace Event
+{
+  struct Power {};
+  struct Play {};
+  struct Stop {};
+  struct Next {};
+}
+
+struct Action_log {
+  std::string entries;
+};
+
+namespace Action
+{
+  template<char IdV>
+  struct Log {
+    template<typename SrcStateT, typename EventT>
+    void operator()(Action_log& context, SrcStateT&, const EventT&)
+    {
+      context.entries += IdV;
+    }
+  };
+}
+
+struct Jukebox : uhsm::State_machine<Jukebox> {
+  struct Off : Simple_state<Off> {};
+
+  struct On : Substate_machine<On> {
+    struct Stopped : Simple_state<Stopped> {};
+
+    struct Playing : Substate_machine<Playing> {
+      struct Track_a : Simple_state<Track_a> {};
+      struct Track_b : Simple_state<Track_b> {};
+
+      using Initial = Track_a;
+      using Transitions = Transition_table<
+        Transition<Track_a, Event::Next, Track_b, Action::Log<'n'>>,
+        Transition<Track_b, Event::Next, Track_b, Action::Log<'i'>>
+      >;
+
+      State_data_def<Transitions> state_data;
+    };
+
+    using Initial = Stopped;
+    using Transitions = Transition_table<
+      Transition<Stopped, Event::Play, Playing, Action::Log<'p'>>,
+      Transition<Playing, Event::Stop, Stopped>,
+      Transition<Playing, Event::Play, Playing, Action::Log<'r'>>
+    >;
+
+    State_data_def<Transitions> state_data;
+  };
+
+  using Initial = Off;
+  using Transitions = Transition_table<
+    Transition<Off, Event::Power, On, Action::Log<'o'>>,
+    Transition<On, Event::Power, Off>
+  >;
+
+  State_data_def<Transitions> state_data;
+  Action_log context;
+};
+
+using Jukebox_description = uhsm::Runtime_description_of<Jukebox, Event::Power, Event::Play, Event::Stop, Event::Next>;
+
+template<typename ActionT>
+void log_action(Action_log& context, const uhsm::Runtime_event&)
+{
+  Jukebox::Off src;
+  ActionT{}(context, src, Event::Power{});
+}
+
+template<typename... ActionTs>
+constexpr std::array<uhsm::Runtime_machine<Action_log>::Action, sizeof...(ActionTs)> make_registry(std::tuple<ActionTs...>*)
+{
+  return {{&log_action<ActionTs>...}};
+}
+
+TEST_GROUP(RuntimeMachine_TestGroup)
+{
+};
+
+TEST(RuntimeMachine_TestGroup, React_ConvertedDescription_AgreesWithCompiledMachine)
+{
+  static constexpr auto registry = make_registry(static_cast<Jukebox_description::Actions*>(nullptr));
+  const auto& image = Jukebox_description::image;
+
+  // NOTE: a description is used in place, e.g. from a memory-mapped file
+  alignas(Jukebox_description::Image) unsigned char file[sizeof(image)];
+  std::memcpy(file, &image, sizeof(image));
+
+  Action_log runtime_log;
+  uhsm::Runtime_machine<Action_log> runtime_sm{file, sizeof(file), registry.data(), registry.size(), runtime_log};
+  CHECK(runtime_sm.validate());
+
+  Jukebox sm;
+  sm.start();
+  runtime_sm.start();
+  LONGS_EQUAL(sm.current_leaf_id(), runtime_sm.current_leaf_id());
+
+  // event indices within the event list of the description
+  const uhsm::Runtime_format::Id script[] = {3, 0, 1, 3, 3, 1, 2, 2, 1, 0, 1, 0, 1, 3};
+  for (const auto event : script) {
+    bool handled = false;
+    switch (event) {
+      case 0: handled = sm.react(Event::Power{}); break;
+      case 1: handled = sm.react(Event::Play{}); break;
+      case 2: handled = sm.react(Event::Stop{}); break;
+      case 3: handled = sm.react(Event::Next{}); break;
+    }
+
+    CHECK_EQUAL(handled, runtime_sm.react(event));
+    LONGS_EQUAL(sm.current_leaf_id(), runtime_sm.current_leaf_id());
+  }
+  STRCMP_EQUAL(sm.context.entries.c_str(), runtime_log.entries.c_str());
+}
+
+TEST(RuntimeMachine_TestGroup, React_HookActionsInDescription_ExitedInnermostFirstThenEntered)
+{
+  using Format = uhsm::Runtime_format;
+  constexpr Format::Id none = Format::no_id;
+  // 0: A { 1: A1, 2: A2 }, 3: B; A1 -e0-> A2, A -e1-> B; hooks log the state identifier
+  struct {
+    Format::Header header;
+    Format::State states[4];
+    Format::Transition transitions[2];
+  } description = {
+    {Format::magic, 4, 0, 2},
+    {
+      {none, 1, 0, 4, 0, 1, 0},
+      {0, none, 1, 5, 1, 1, 0},
+      {0, none, 2, 6, 2, 0, 0},
+      {none, none, 3, 7, 2, 0, 0}
+    },
+    {{1, 3, none, 0}, {0, 2, none, 0}}
+  };
+
+  static constexpr uhsm::Runtime_machine<std::string>::Action hooks[] = {
+    [](std::string& log, const uhsm::Runtime_event&) { log += "+0"; },
+    [](std::string& log, const uhsm::Runtime_event&) { log += "+1"; },
+    [](std::string& log, const uhsm::Runtime_event&) { log += "+2"; },
+    [](std::string& log, const uhsm::Runtime_event&) { log += "+3"; },
+    [](std::string& log, const uhsm::Runtime_event&) { log += "-0"; },
+    [](std::string& log, const uhsm::Runtime_event&) { log += "-1"; },
+    [](std::string& log, const uhsm::Runtime_event&) { log += "-2"; },
+    [](std::string& log, const uhsm::Runtime_event&) { log += "-3"; }
+  };
+
+  std::string log;
+  uhsm::Runtime_machine<std::string> sm{&description, sizeof(description), hooks, 8, log};
+  CHECK(sm.validate());
+  sm.start();
+
+  CHECK(sm.react(0));
+  CHECK(sm.react(1));
+  CHECK_FALSE(sm.react(0));
+  CHECK(sm.is_in(3));
+  STRCMP_EQUAL("-1+2-2-0+3", log.c_str());
+
+  uhsm::Runtime_machine<std::string> short_registry{&description, sizeof(description), hooks, 4, log};
+  CHECK(short_registry.loaded());
+  CHECK_FALSE(short_registry.validate());
+}
+
+TEST(RuntimeMachine_TestGroup, Start_DescriptionNotLoaded_RefusedAndNoEventHandled)
+{
+  using Format = uhsm::Runtime_format;
+  struct {
+    Format::Header header;
+    Format::State states[1];
+  } description = {
+    {{{'U', 'H', 'S', 'M', 'R', 'T', 'M', '0'}}, 1, 0, 0},
+    {{Format::no_id, Format::no_id, Format::no_id, Format::no_id, 0, 0, 0}}
+  };
+
+  int context = 0;
+  uhsm::Runtime_machine<int> bad_magic{&description, sizeof(description), nullptr, 0, context};
+  uhsm::Runtime_machine<int> bad_size{&description, sizeof(description) - 1, nullptr, 0, context};
+
+  for (auto* sm : {&bad_magic, &bad_size}) {
+    CHECK_FALSE(sm->loaded());
+    CHECK_FALSE(sm->validate());
+    CHECK_FALSE(sm->start());
+    CHECK_FALSE(sm->react(0));
+    CHECK_FALSE(sm->is_in(0));
+  }
+}
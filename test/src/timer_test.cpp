@@ -0,0 +1,115 @@
+#include <CppUTest/TestHarness.h>
+#include "uhsm/state_machine.h"
+#include "uhsm/timer_wheel.h"
+
+namespace Event
+{
+  struct Open_btn {};
+  struct Close_btn {};
+  struct Hold_timeout {};
+  struct Reminder {};
+}
+
+struct Timed_door;
+
+struct Door_context {
+  uhsm::Timer_wheel<Timed_door>* timers;
+  int reminder_count;
+};
+
+namespace Action
+{
+  struct Count_reminder {
+    template<typename SrcStateT, typename EventT>
+    void operator()(Door_context& context, const SrcStateT&, const EventT&)
+    {
+      ++context.reminder_count;
+    }
+  };
+}
+
+struct Timed_door : uhsm::State_machine<Timed_door> {
+  struct Closed : Simple_state<Closed> {};
+
+  struct Opened : Substate_machine<Opened> {
+    // NOTE: timers are armed in hooks taking the context of the state machine
+    struct Holding : Simple_state<Holding> {
+      uhsm::State_timer<Event::Hold_timeout> hold_timer;
+
+      template<typename EventT>
+      void on_entry(Door_context& context, const EventT&) { hold_timer.start(*context.timers, 10); }
+    };
+    struct Alarm : Simple_state<Alarm> {
+      uhsm::State_timer<Event::Reminder> reminder_timer;
+
+      template<typename EventT>
+      void on_entry(Door_context& context, const EventT&) { reminder_timer.start(*context.timers, 70000); }
+    };
+
+    using Initial = Holding;
+    using Transitions = Transition_table<
+      Transition<Holding, Event::Hold_timeout, Alarm>,
+      Transition<Alarm, Event::Reminder, Alarm, Action::Count_reminder>
+    >;
+
+    State_data_def<Transitions> state_data;
+  };
+
+  using Initial = Closed;
+  using Transitions = Transition_table<
+    Transition<Closed, Event::Open_btn, Opened>,
+    Transition<Opened, Event::Close_btn, Closed>
+  >;
+
+  State_data_def<Transitions> state_data;
+  Door_context context;
+};
+
+TEST_GROUP(Timer_TestGroup)
+{
+  uhsm::Timer_wheel<Timed_door> wheel;
+  Timed_door sm{};
+
+  void setup()
+  {
+    sm.context.timers = &wheel;
+    sm.start();
+  }
+};
+
+TEST(Timer_TestGroup, Advance_HoldTimeoutElapsed_AlarmEntered)
+{
+  sm.react(Event::Open_btn{});
+
+  LONGS_EQUAL(0, wheel.advance(sm, 9));
+  CHECK(sm.is_in<Timed_door::Opened::Holding>());
+
+  LONGS_EQUAL(1, wheel.advance(sm));
+  CHECK(sm.is_in<Timed_door::Opened::Alarm>());
+}
+
+TEST(Timer_TestGroup, Advance_StateExitedBeforeTimeout_TimeoutNotDelivered)
+{
+  sm.react(Event::Open_btn{});
+  wheel.advance(sm, 5);
+
+  // NOTE: the timer is cancelled with its state although it is exited by a transition of its parent
+  sm.react(Event::Close_btn{});
+
+  LONGS_EQUAL(0, wheel.advance(sm, 100));
+  CHECK(sm.is_in<Timed_door::Closed>());
+}
+
+TEST(Timer_TestGroup, Advance_DelayBeyondLowestLevel_DeliveredAtExactTick)
+{
+  sm.react(Event::Open_btn{});
+  wheel.advance(sm, 10);
+
+  LONGS_EQUAL(0, wheel.advance(sm, 69999));
+  LONGS_EQUAL(0, sm.context.reminder_count);
+
+  // NOTE: an internal transition neither exits the state nor cancels its timer
+  LONGS_EQUAL(1, wheel.advance(sm));
+  LONGS_EQUAL(1, sm.context.reminder_count);
+  CHECK(sm.is_in<Timed_door::Opened::Alarm>());
+}
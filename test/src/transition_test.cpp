@@ -9,6 +9,7 @@ namespace Event
   struct Stop_btn {};
   struct Forward_btn {};
   struct Backward_btn {};
+  struct Telemetry_sample {};
 }
 
 struct Player : uhsm::State_machine<Player> {
@@ -48,6 +49,18 @@ struct Player : uhsm::State_machine<Player> {
   State_data_def<Transitions> state_data;
 };
 
+// events are mapped to state hierarchy levels which can handle them at compile time
+static_assert(uhsm::helpers::handles_event_v<Player, Event::Pwr_switch_flip>);
+static_assert(uhsm::helpers::handles_event_v<Player::Powered_on, Event::Play_pause_btn>);
+static_assert(!uhsm::helpers::handles_event_v<Player::Powered_on, Event::Pwr_switch_flip>);
+static_assert(!uhsm::helpers::handles_event_v<Player::Powered_on::Stopped, Event::Play_pause_btn>);
+static_assert(!uhsm::helpers::handles_event_v<Player, Event::Telemetry_sample>);
+
+// states are numbered in depth-first pre-order
+static_assert(uhsm::helpers::state_id_v<Player, Player::Powered_off> == 0);
+static_assert(uhsm::helpers::state_id_v<Player, Player::Powered_on::Active::Paused> == 5);
+static_assert(uhsm::helpers::initial_leaf_id_v<Player, Player::Powered_on::Active> == 4);
+
 TEST_GROUP(Transition_TestGroup)
 {
 };
@@ -216,3 +229,72 @@ TEST(Transition_TestGroup, React_UnsupportedEventPassed_EventIgnored)
   Player::Powered_off>(sm);
   CHECK(in_state);
 }
+
+TEST(Transition_TestGroup, React_EventNotHandledByAnyState_EventIgnored)
+{
+  Player sm;
+  sm.start();     // initialized with 'Off'
+
+  sm.react(Event::Pwr_switch_flip{});   // enters 'Powered_on::Stopped'
+  const bool handled = sm.react(Event::Telemetry_sample{});
+
+  CHECK_FALSE(handled);
+
+  const bool in_state = uhsm::helpers::is_in_state<
+  Player,
+  Player::Powered_on,
+  Player::Powered_on::Stopped>(sm);
+  CHECK(in_state);
+}
+
+TEST(Transition_TestGroup, React_LvalueEventPassed_InExpectedState)
+{
+  Player sm;
+  sm.start();     // initialized with 'Off'
+
+  Event::Pwr_switch_flip pwr_switch_flip{};
+  const Event::Play_pause_btn play_pause_btn{};
+  sm.react(pwr_switch_flip);    // enters 'Powered_on::Stopped'
+  sm.react(play_pause_btn);     // enters 'Powered_on::Active::Playing'
+
+  const bool in_state = uhsm::helpers::is_in_state<
+  Player,
+  Player::Powered_on,
+  Player::Powered_on::Active,
+  Player::Powered_on::Active::Playing>(sm);
+  CHECK(in_state);
+}
+
+TEST(Transition_TestGroup, IsIn_CascadeInTr1_NestedStatesCurrent)
+{
+  Player sm;
+  sm.start();     // initialized with 'Off'
+  sm.react(Event::Pwr_switch_flip{});   // enters 'Powered_on::Stopped'
+  sm.react(Event::Play_pause_btn{});    // enters 'Powered_on::Active::Playing'
+
+  CHECK(sm.is_in<Player::Powered_on>());
+  CHECK(sm.is_in<Player::Powered_on::Active>());
+  CHECK(sm.is_in<Player::Powered_on::Active::Playing>());
+  CHECK_FALSE(sm.is_in<Player::Powered_off>());
+  CHECK_FALSE(sm.is_in<Player::Powered_on::Stopped>());
+  CHECK_FALSE(sm.is_in<Player::Powered_on::Active::Paused>());
+  
+  const auto leaf_id = uhsm::helpers::state_id_v<Player, Player::Powered_on::Active::Playing>;
+  LONGS_EQUAL(leaf_id, sm.current_leaf_id());
+}
+
+TEST(Transition_TestGroup, IsIn_CascadeOutTr1_OuterStateCurrent)
+{
+  Player sm;
+  sm.start();     // initialized with 'Off'
+  CHECK(sm.is_in<Player::Powered_off>());
+  
+  sm.react(Event::Pwr_switch_flip{});   // enters 'Powered_on::Stopped'
+  sm.react(Event::Play_pause_btn{});    // enters 'Powered_on::Active::Playing'
+  sm.react(Event::Play_pause_btn{});    // enters 'Powered_on::Active::Paused'
+  CHECK(sm.is_in<Player::Powered_on::Active::Paused>());
+  
+  sm.react(Event::Pwr_switch_flip{});   // leaves 'Powered_on' substate, enters 'Powered_off'
+  CHECK(sm.is_in<Player::Powered_off>());
+  CHECK_FALSE(sm.is_in<Player::Powered_on>());
+}
@@ -0,0 +1,332 @@
+#!/usr/bin/env python3
+"""Generates a UHSM state machine header from a compact machine description.
+
+The emitted header declares the machine with the regular `State_machine`/`Substate_machine`
+API, but with all type lists precomputed (the set of nested states of each state machine,
+the depth-first list of all nested states and, for the compact dispatch mode, encoded
+transition tables), so the compiler does not have to derive them from transition tables.
+
+Description format (one statement per line, `#` starts a comment):
+
+    include "events.h"              emitted as #include
+    namespace Gen                   namespace of the generated code (optional)
+    event Pwr_switch_flip           declares an (empty) event type
+    machine Player {                the topmost state machine
+      dispatch compact              dispatch mode (inlined, compact, flat, iterative)
+      context Player_data           type of the `context` data member
+      initial Powered_off
+      state Powered_off : Hooks     a simple state; optional base class providing hooks
+      state Powered_on {            a substate machine (same statements as `machine`)
+        ...
+      }
+      Powered_off + Pwr_switch_flip -> Powered_on / Action::Beep
+    }
+
+Usage: uhsm_gen.py <description> -o <header>
+"""
+
+import argparse
+import re
+import sys
+
+
+class Description_error(Exception):
+    pass
+
+
+class State:
+    def __init__(self, name, base=None, line=0):
+        self.name = name
+        self.base = base
+        self.line = line
+        self.composite = False
+        self.states = []
+        self.transitions = []
+        self.initial = None
+        self.dispatch = None
+        self.context = None
+
+    def state_list(self):
+        """Nested states in order of their last appearance as a source state (as the library orders them)."""
+        order = []
+        for src, _, _, _ in reversed(self.transitions):
+            if src not in order:
+                order.insert(0, src)
+        return [self.find(name) for name in order]
+
+    def nested_state_list(self, prefix=''):
+        """All nested states in depth-first pre-order, as qualified names relative to this state."""
+        result = []
+        for state in self.state_list():
+            name = prefix + state.name
+            result.append(name)
+            if state.composite:
+                result += state.nested_state_list(name + '::')
+        return result
+
+    def find(self, name):
+        for state in self.states:
+            if state.name == name:
+                return state
+        return None
+
+
+STATE_RE = re.compile(r'^state\s+(\w+)(?:\s*:\s*([\w:<>, ]+?))?\s*(\{)?$')
+MACHINE_RE = re.compile(r'^machine\s+(\w+)\s*\{$')
+TRANSITION_RE = re.compile(r'^(\w+)\s*\+\s*([\w:]+)\s*->\s*(\w+)(?:\s*/\s*([\w:<>, ]+))?$')
+
+
+def parse(lines):
+    includes, events, namespace, root = [], [], None, None
+    stack = []
+
+    for line_no, raw in enumerate(lines, 1):
+        line = raw.split('#', 1)[0].strip()
+        if not line:
+            continue
+
+        def fail(message):
+            raise Description_error('line {}: {}'.format(line_no, message))
+
+        if not stack:
+            if line.startswith('include '):
+                includes.append(line.split(None, 1)[1])
+            elif line.startswith('namespace '):
+                namespace = line.split(None, 1)[1]
+            elif line.startswith('event '):
+                events.append(line.split(None, 1)[1])
+            elif MACHINE_RE.match(line):
+                if root is not None:
+                    fail('only one machine can be described')
+                root = State(MACHINE_RE.match(line).group(1), line=line_no)
+                root.composite = True
+                stack.append(root)
+            else:
+                fail('unexpected statement: ' + line)
+            continue
+
+        current = stack[-1]
+        state_match = STATE_RE.match(line)
+        transition_match = TRANSITION_RE.match(line)
+
+        if line == '}':
+            stack.pop()
+        elif state_match:
+            name, base, opens = state_match.groups()
+            if current.find(name):
+                fail('state {} declared twice'.format(name))
+            state = State(name, base.strip() if base else None, line_no)
+            current.states.append(state)
+            if opens:
+                state.composite = True
+                stack.append(state)
+        elif transition_match:
+            current.transitions.append(transition_match.groups())
+        elif line.startswith('initial '):
+            current.initial = line.split(None, 1)[1]
+        elif line.startswith('dispatch ') and current is root:
+            current.dispatch = line.split(None, 1)[1]
+            if current.dispatch not in ('inlined', 'compact', 'flat', 'iterative'):
+                fail('unknown dispatch mode ' + current.dispatch)
+        elif line.startswith('context ') and current is root:
+            current.context = line.split(None, 1)[1]
+        else:
+            fail('unexpected statement: ' + line)
+
+    if stack:
+        raise Description_error('unterminated block of {}'.format(stack[-1].name))
+    if root is None:
+        raise Description_error('no machine described')
+
+    return includes, events, namespace, root
+
+
+# NOTE: encoded compact tables index rows, states and events by bytes, 0xFF marking no transition
+max_compact_items = 254
+
+
+def validate(machine, compact):
+    def fail(message):
+        raise Description_error('line {}: {}'.format(machine.line, message))
+
+    if not machine.states:
+        fail('{} has no states'.format(machine.name))
+    if machine.find(machine.initial or '') is None:
+        fail('{} has no (valid) initial state'.format(machine.name))
+
+    sources = set()
+    for src, _, dest, _ in machine.transitions:
+        for name in (src, dest):
+            if machine.find(name) is None:
+                fail('transition of {} refers to unknown state {}'.format(machine.name, name))
+        sources.add(src)
+
+    # NOTE: the library derives the set of states from source states of the transition table
+    for state in machine.states:
+        if state.name not in sources:
+            fail('state {} of {} is not a source state of any transition'.format(state.name, machine.name))
+
+    if compact:
+        events = set(event for _, event, _, _ in machine.transitions)
+        for what, count in (('transitions', len(machine.transitions)), ('states', len(machine.state_list())),
+                            ('events', len(events))):
+            if count > max_compact_items:
+                fail('{} has {} {}; compact dispatch supports up to {} per hierarchy level'.format(
+                    machine.name, count, what, max_compact_items))
+
+    for state in machine.states:
+        if state.composite:
+            validate(state, compact)
+
+
+def emit_state(out, state, indent, is_root):
+    pad = '  ' * indent
+
+    if not state.composite:
+        if state.base:
+            out.append('{}struct {} : Simple_state<{}>, {} {{'.format(pad, state.name, state.name, state.base))
+            out.append('{}  using {}::on_entry;'.format(pad, state.base))
+            out.append('{}  using {}::on_exit;'.format(pad, state.base))
+            out.append('{}}};'.format(pad))
+        else:
+            out.append('{}struct {} : Simple_state<{}> {{}};'.format(pad, state.name, state.name))
+        return
+
+    if not is_root:
+        bases = 'Substate_machine<{}>'.format(state.name)
+        if state.base:
+            bases += ', ' + state.base
+        out.append('{}struct {} : {} {{'.format(pad, state.name, bases))
+        if state.base:
+            out.append('{}  using {}::on_entry;'.format(pad, state.base))
+            out.append('{}  using {}::on_exit;'.format(pad, state.base))
+
+    inner = pad + '  ' if not is_root else pad
+    if is_root and state.dispatch:
+        out.append('{}static constexpr auto dispatch_mode = uhsm::Dispatch_mode::{};'.format(inner, state.dispatch))
+
+    for nested in state.states:
+        emit_state(out, nested, indent + (0 if is_root else 1), False)
+
+    rows = []
+    for src, event, dest, action in state.transitions:
+        rows.append('Transition<{}, {}, {}{}>'.format(src, event, dest, ', ' + action.strip() if action else ''))
+    state_list = ', '.join(s.name for s in state.state_list())
+
+    out.append('')
+    out.append('{}using Initial = {};'.format(inner, state.initial))
+    out.append('{}using Transitions = Transition_table<'.format(inner))
+    out.append(',\n'.join('{}  {}'.format(inner, row) for row in rows))
+    out.append('{}>;'.format(inner))
+    out.append('{}// precomputed type lists'.format(inner))
+    out.append('{}using State_list = std::tuple<{}>;'.format(inner, state_list))
+    out.append('{}using Nested_state_list = std::tuple<{}>;'.format(inner, ', '.join(state.nested_state_list())))
+    out.append('')
+    out.append('{}std::variant<{}> state_data;'.format(inner, state_list))
+    if is_root and state.context:
+        out.append('{}{} context;'.format(inner, state.context))
+
+    if not is_root:
+        out.append('{}}};'.format(pad))
+
+
+def emit_compact_tables(out, state, qualified, qualify_event):
+    states = [s.name for s in state.state_list()]
+    events = []
+    for _, event, _, _ in state.transitions:
+        if event not in events:
+            events.append(event)
+
+    values = []
+    for src, event, dest, _ in state.transitions:
+        values += [states.index(src), events.index(event), states.index(dest)]
+
+    out.append('  template<>')
+    out.append('  struct Compact_table<{}> {{'.format(qualified))
+    out.append('    static constexpr std::size_t row_count = {};'.format(len(state.transitions)))
+    out.append('    static constexpr std::array<std::uint8_t, {}> rows = {{{{{}}}}};'.format(
+        len(values), ', '.join(str(v) for v in values)))
+    out.append('')
+    out.append('    template<typename EventT>')
+    out.append('    static constexpr std::uint8_t event_idx = static_cast<std::uint8_t>(')
+    out.append('      utils::tuple_elem_idx_v<EventT, std::tuple<{}>>);'.format(
+        ', '.join(qualify_event(event) for event in events)))
+    out.append('  };')
+
+    for nested in state.state_list():
+        if nested.composite:
+            emit_compact_tables(out, nested, qualified + '::' + nested.name, qualify_event)
+
+
+def generate(includes, events, namespace, root, source_name):
+    guard = 'UHSM_GEN_{}_H_'.format(re.sub(r'\W', '_', root.name).upper())
+    out = [
+        '// NOTE: generated by tools/uhsm_gen.py from {}; do not edit'.format(source_name),
+        '#ifndef {}'.format(guard),
+        '#define {}'.format(guard),
+        '',
+        '#include <array>',
+        '#include <cstdint>',
+        '#include <tuple>',
+        '#include <variant>',
+        '#include "uhsm/state_machine.h"',
+    ]
+    out += ['#include {}'.format(include) for include in includes]
+    out.append('')
+
+    scope = ''
+    if namespace:
+        out.append('namespace {}'.format(namespace))
+        out.append('{')
+        scope = namespace + '::'
+
+    for event in events:
+        out.append('  struct {} {{}};'.format(event))
+    if events:
+        out.append('')
+
+    out.append('  struct {} : uhsm::State_machine<{}> {{'.format(root.name, root.name))
+    emit_state(out, root, 2, True)
+    out.append('  };')
+
+    if namespace:
+        out.append('}')
+
+    if root.dispatch == 'compact':
+        # NOTE: `Compact_table` is specialized in the namespace of the library, so event types declared
+        # in the description are qualified; other event types must be named as seen from the global scope
+        qualify_event = lambda event: '::' + scope + event if event in events else event
+        out.append('')
+        out.append('// precomputed encoded transition tables for compact dispatch')
+        out.append('namespace uhsm::helpers')
+        out.append('{')
+        emit_compact_tables(out, root, '::' + scope + root.name, qualify_event)
+        out.append('}')
+
+    out.append('')
+    out.append('#endif')
+    return '\n'.join(out) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generates a UHSM state machine header from a machine description.')
+    parser.add_argument('description')
+    parser.add_argument('-o', '--output', required=True)
+    args = parser.parse_args()
+
+    try:
+        with open(args.description) as description:
+            includes, events, namespace, root = parse(description.readlines())
+        validate(root, root.dispatch == 'compact')
+    except Description_error as error:
+        sys.stderr.write('{}: {}\n'.format(args.description, error))
+        return 1
+
+    header = generate(includes, events, namespace, root, args.description.replace('\\', '/').split('/')[-1])
+    with open(args.output, 'w') as output:
+        output.write(header)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())